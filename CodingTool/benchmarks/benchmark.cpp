@@ -0,0 +1,384 @@
+/*!
+  \file benchmark.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief Benchmarks of the primitives and of the low weight search.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+
+
+#include "LowWeightSearch.h"
+#include "InputHandler.h"
+#include "RowKernels.h"
+#include "ColumnGather.h"
+#include "types.h"
+#include "../examples/sha1me.h"
+
+using namespace std;
+
+//! The seed of all random matrices.
+static const uint32_t SEED = 0x5EED1234;
+//! Minimal time of one measurement in seconds.
+static const double MINTIME = 0.2;
+
+//! The result of one benchmark.
+struct Result {
+	string   sName;     //!< Name of the benchmark.
+	string   sSize;     //!< Size of the input, e.g. "512x1920".
+	string   sKernel;   //!< The row kernel in use.
+	uint64_t dOps;      //!< Number of operations.
+	uint64_t dBytes;    //!< Number of processed bytes, 0 if not meaningful.
+	double   dSeconds;  //!< Time of all operations.
+};
+
+//! One benchmark, Run does dReps operations.
+class Benchmark {
+public:
+	virtual ~Benchmark() {}
+	virtual void Run(uint64_t dReps) = 0;
+};
+
+//! Keeps the compiler from removing the benchmarked code.
+static volatile uint64_t g_dSink = 0;
+
+static vector<Result> g_vResults;
+
+CodeMatrix RandomMatrix(uint64_t dRows, uint64_t dColumns, uint32_t dSeed);
+string Size(uint64_t dRows, uint64_t dColumns);
+void Measure(const string & sName, const string & sSize, Benchmark & oBenchmark, uint64_t dBytesPerOp);
+void WriteResults(const string & sFileName);
+
+//! RowXorWeight on two rows.
+class XorBenchmark : public Benchmark {
+public:
+	XorBenchmark(uint64_t dWords) : m_vDst(dWords), m_vSrc(dWords) {
+		RandomNumberGenerator oRnGen;
+		oRnGen.setSeed(SEED);
+		for(uint64_t i = 0; i < dWords; i++) {
+			m_vDst[i] = oRnGen.getRandom64();
+			m_vSrc[i] = oRnGen.getRandom64();
+		}
+	}
+	virtual void Run(uint64_t dReps) {
+		uint64_t dSum = 0;
+		for(uint64_t i = 0; i < dReps; i++)
+			dSum += RowXorWeight(&m_vDst[0], &m_vSrc[0], m_vDst.size());
+		g_dSink += dSum;
+	}
+private:
+	vector<uint64_t> m_vDst;
+	vector<uint64_t> m_vSrc;
+};
+
+//! RowWeight (popcount) of a row.
+class WeightBenchmark : public Benchmark {
+public:
+	WeightBenchmark(uint64_t dWords) : m_vRow(dWords) {
+		RandomNumberGenerator oRnGen;
+		oRnGen.setSeed(SEED);
+		for(uint64_t i = 0; i < dWords; i++)
+			m_vRow[i] = oRnGen.getRandom64();
+	}
+	virtual void Run(uint64_t dReps) {
+		uint64_t dSum = 0;
+		for(uint64_t i = 0; i < dReps; i++) {
+			m_vRow[i % m_vRow.size()] ^= i;
+			dSum += RowWeight(&m_vRow[0], m_vRow.size());
+		}
+		g_dSink += dSum;
+	}
+private:
+	vector<uint64_t> m_vRow;
+};
+
+//! GetSubMatrix of all rows and a window of random columns, as used by the engines.
+class SubMatrixBenchmark : public Benchmark {
+public:
+	SubMatrixBenchmark(const CodeMatrix & oMatrix, uint64_t dColumns) : m_oMatrix(oMatrix) {
+		RandomNumberGenerator oRnGen;
+		oRnGen.setSeed(SEED);
+		for(uint64_t i = 0; i < m_oMatrix.GetRows(); i++)
+			m_vRows.push_back(i);
+		vector<uint64_t> vCols = oRnGen.getRandomPosVector(0, m_oMatrix.GetColumns()-1, dColumns);
+		std::sort(vCols.begin(), vCols.end());
+		m_oGather.SetColumns(vCols);
+	}
+	virtual void Run(uint64_t dReps) {
+		for(uint64_t i = 0; i < dReps; i++) {
+			m_oMatrix.GetSubMatrix(m_vRows, m_oGather, m_oWindow);
+			g_dSink += m_oWindow[i % m_oWindow.GetRows()].At64(0);
+		}
+	}
+private:
+	CodeMatrix       m_oMatrix;
+	vector<uint64_t> m_vRows;
+	ColumnGather     m_oGather;
+	CodeMatrix       m_oWindow;
+};
+
+//! GaussMod2 of a fixed matrix (ComputeSystematicForm), the Gauss combinations are disabled.
+class GaussBenchmark : public Benchmark {
+public:
+	GaussBenchmark(const CodeMatrix & oMatrix) : m_oMatrix(oMatrix) {}
+	virtual void Run(uint64_t dReps) {
+		for(uint64_t i = 0; i < dReps; i++) {
+			LowWeightSearch::SystematicForm oForm;
+			LowWeightSearch oLowWS;
+			oLowWS.ComputeSystematicForm(m_oMatrix, oForm);
+			g_dSink += oForm.vGaussPerm.size();
+		}
+	}
+private:
+	CodeMatrix m_oMatrix;
+};
+
+//! CodeShortening of the last columns of a matrix.
+class ShorteningBenchmark : public Benchmark {
+public:
+	ShorteningBenchmark(const CodeMatrix & oMatrix, uint64_t dColumns) : m_oMatrix(oMatrix) {
+		for(uint64_t i = 0; i < dColumns; i++)
+			m_vColumns.push_back(m_oMatrix.GetColumns()-dColumns+i);
+	}
+	virtual void Run(uint64_t dReps) {
+		for(uint64_t i = 0; i < dReps; i++) {
+			CodeMatrix oCopy = m_oMatrix;
+			g_dSink += LowWeightSearch::CodeShortening(oCopy, m_vColumns).GetRows();
+		}
+	}
+private:
+	CodeMatrix       m_oMatrix;
+	vector<uint64_t> m_vColumns;
+};
+
+/*!
+    This program measures the primitives of the library and the
+	throughput of the low weight search. Random matrices and the
+	search use a fixed seed, thus every run does the same work.
+
+	The benchmarks are:
+	- row XOR with weight (RowXorWeight) and popcount (RowWeight)
+	  for several row lengths, once for each row kernel supported
+	  by the CPU
+	- GetSubMatrix of a random window of sigma columns
+	- LowWeightSearch::GaussMod2 of random matrices
+	- LowWeightSearch::CodeShortening of the SHA-1 message
+	  expansion code
+	- iterations per second of LowWeightSearch::CanteautChabaud on
+	  the 512x1920 SHA-1 message expansion code (see sha1me.h), the
+	  systematic form is computed before the timer starts
+
+	The results are written to "-o file" (default is benchmark.json),
+	as CSV if the file name ends with ".csv", otherwise as JSON.
+	"-i n" sets the number of iterations of the search (default is 500).
+	"make benchmark" builds the program and runs it in bin/.
+
+	\see sha1me.cpp
+*/
+int main(int argc, const char* argv[]) {
+
+	string   sOutput     = "benchmark.json";
+	uint64_t dIterations = 500;
+
+	// example: ./benchmark -o results.csv -i 200
+	for(int i = 1; i < argc; i++) {
+		string sArg = argv[i];
+		if(sArg == "-o" && i+1 < argc)
+			sOutput = argv[++i];
+		else if(sArg == "-i" && i+1 < argc)
+			dIterations = strtoull(argv[++i], NULL, 10);
+		else {
+			cout << "Usage: " << argv[0] << " [-o file] [-i iterations]" << endl;
+			exit(-1);
+		}
+	}
+
+	CodeMatrix oSHA1;
+	oSHA1.Build(&BuildFunction, 512);
+
+	// row kernels, each supported implementation
+	KernelType aKernels[] = { KERNEL_SCALAR, KERNEL_POPCNT, KERNEL_AVX2, KERNEL_AVX512 };
+	uint64_t aWords[] = { 4, 30, 256, 4096 };
+	for(uint64_t k = 0; k < sizeof(aKernels)/sizeof(aKernels[0]); k++) {
+		if(!SetRowKernel(aKernels[k]))
+			continue;
+		for(uint64_t w = 0; w < sizeof(aWords)/sizeof(aWords[0]); w++) {
+			XorBenchmark oXor(aWords[w]);
+			Measure("RowXorWeight", Size(1, 64*aWords[w]), oXor, 16*aWords[w]);
+			WeightBenchmark oWeight(aWords[w]);
+			Measure("RowWeight", Size(1, 64*aWords[w]), oWeight, 8*aWords[w]);
+		}
+	}
+	SetRowKernel(KERNEL_AUTO);
+
+	// window of the engines
+	SubMatrixBenchmark oSubSHA1(oSHA1, 20);
+	Measure("GetSubMatrix", Size(512, 1920), oSubSHA1, 0);
+	CodeMatrix oLarge = RandomMatrix(4096, 8192, SEED);
+	SubMatrixBenchmark oSubLarge(oLarge, 32);
+	Measure("GetSubMatrix", Size(4096, 8192), oSubLarge, 0);
+
+	// Gaussian elimination
+	uint64_t aGauss[][2] = { {256, 1024}, {512, 1920}, {1024, 4096}, {2048, 8192} };
+	for(uint64_t g = 0; g < sizeof(aGauss)/sizeof(aGauss[0]); g++) {
+		GaussBenchmark oGauss(RandomMatrix(aGauss[g][0], aGauss[g][1], SEED));
+		Measure("GaussMod2", Size(aGauss[g][0], aGauss[g][1]), oGauss, 0);
+	}
+
+	// code shortening
+	uint64_t aShortening[] = { 32, 160, 320 };
+	for(uint64_t s = 0; s < sizeof(aShortening)/sizeof(aShortening[0]); s++) {
+		ShorteningBenchmark oShortening(oSHA1, aShortening[s]);
+		ostringstream oName;
+		oName << "CodeShortening " << aShortening[s];
+		Measure(oName.str(), Size(512, 1920), oShortening, 0);
+	}
+
+	// end-to-end search, one chain with the default parameters
+	if(dIterations > 0) {
+		Parameters oParameters;
+		InputHandler oInputHandler(oParameters);
+		LowWeightSearch oLowWS;
+		oParameters.SetParameter(Parameters::ITER, dIterations);
+		oParameters.SetParameter(Parameters::DOUTPUT, 1);
+		oParameters.SetParameter(Parameters::OUTPUT, "benchmark.cw");
+		oParameters.SetParameter(Parameters::SEED, SEED);
+
+		// the Gauss elimination is measured above, the search starts
+		// with the systematic form and only the iterations are timed
+		LowWeightSearch::SystematicForm oForm;
+		oLowWS.ComputeSystematicForm(oSHA1, oForm);
+		oLowWS.SetSystematicForm(&oForm);
+
+		chrono::steady_clock::time_point tStart = chrono::steady_clock::now();
+		oLowWS.CanteautChabaud(oSHA1, oParameters);
+		double dSeconds = chrono::duration<double>(chrono::steady_clock::now()-tStart).count();
+		remove("benchmark.cw");
+
+		const SearchStatistics & oStatistics = oLowWS.GetStatistics();
+		Result oResult;
+		oResult.sName    = "CanteautChabaud iteration";
+		oResult.sSize    = Size(512, 1920);
+		oResult.sKernel  = GetRowKernelName();
+		oResult.dOps     = oStatistics.dIterations;
+		oResult.dBytes   = 0;
+		oResult.dSeconds = dSeconds;
+		g_vResults.push_back(oResult);
+		cout << "Info: " << oResult.sName << " " << oResult.dOps/dSeconds << " per second" << endl;
+	}
+
+	WriteResults(sOutput);
+	exit(0);
+}
+
+CodeMatrix
+RandomMatrix(uint64_t dRows, uint64_t dColumns, uint32_t dSeed) {
+	RandomNumberGenerator oRnGen;
+	CodeMatrix oMatrix;
+
+	oRnGen.setSeed(dSeed);
+	for(uint64_t i = 0; i < dRows; i++) {
+		CodeWord oRow;
+		for(uint64_t j = 0; j < dColumns; j += 64) {
+			uint64_t dWord = oRnGen.getRandom64();
+			if(dColumns-j < 64)
+				for(uint64_t b = j; b < dColumns; b++)
+					oRow.PushBool(((dWord >> (b-j)) & 1) != 0);
+			else
+				oRow.Push64(dWord);
+		}
+		oMatrix.AddRow(oRow);
+	}
+	return oMatrix;
+}
+
+string
+Size(uint64_t dRows, uint64_t dColumns) {
+	ostringstream oSize;
+	oSize << dRows << "x" << dColumns;
+	return oSize.str();
+}
+
+void
+Measure(const string & sName, const string & sSize, Benchmark & oBenchmark, uint64_t dBytesPerOp) {
+	uint64_t dReps = 1;
+	double dSeconds = 0;
+
+	// warm up, then double the repetitions until the time is measurable
+	oBenchmark.Run(1);
+	while(true) {
+		chrono::steady_clock::time_point tStart = chrono::steady_clock::now();
+		oBenchmark.Run(dReps);
+		dSeconds = chrono::duration<double>(chrono::steady_clock::now()-tStart).count();
+		if(dSeconds >= MINTIME)
+			break;
+		dReps *= 2;
+	}
+
+	Result oResult;
+	oResult.sName    = sName;
+	oResult.sSize    = sSize;
+	oResult.sKernel  = GetRowKernelName();
+	oResult.dOps     = dReps;
+	oResult.dBytes   = dReps*dBytesPerOp;
+	oResult.dSeconds = dSeconds;
+	g_vResults.push_back(oResult);
+
+	cout << "Info: " << sName << " " << sSize << " (" << oResult.sKernel << ") "
+	     << 1e9*dSeconds/dReps << " ns" << endl;
+}
+
+void
+WriteResults(const string & sFileName) {
+	bool bCsv = sFileName.size() >= 4 && sFileName.compare(sFileName.size()-4, 4, ".csv") == 0;
+	ofstream oFile(sFileName.c_str());
+
+	if(oFile.fail()) {
+		cout << "Error: The file " << sFileName << " could not be written." << endl;
+		return;
+	}
+
+	if(bCsv)
+		oFile << "name,size,kernel,ops,seconds,ns_per_op,bytes_per_second" << endl;
+	else
+		oFile << "{\"seed\":" << SEED << ",\"results\":[" << endl;
+	for(uint64_t i = 0; i < g_vResults.size(); i++) {
+		const Result & oResult = g_vResults[i];
+		double dNs   = 1e9*oResult.dSeconds/oResult.dOps;
+		double dRate = oResult.dBytes/oResult.dSeconds;
+		if(bCsv)
+			oFile << oResult.sName << "," << oResult.sSize << "," << oResult.sKernel << ","
+			      << oResult.dOps << "," << oResult.dSeconds << "," << dNs << "," << dRate << endl;
+		else
+			oFile << " {\"name\":\"" << oResult.sName << "\",\"size\":\"" << oResult.sSize
+			      << "\",\"kernel\":\"" << oResult.sKernel << "\",\"ops\":" << oResult.dOps
+			      << ",\"seconds\":" << oResult.dSeconds << ",\"ns_per_op\":" << dNs
+			      << ",\"bytes_per_second\":" << dRate << "}"
+			      << (i+1 < g_vResults.size() ? "," : "") << endl;
+	}
+	if(!bCsv)
+		oFile << "]}" << endl;
+	cout << "Info: The results are written to " << sFileName << endl;
+}
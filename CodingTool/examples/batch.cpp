@@ -0,0 +1,75 @@
+/*!
+  \file batch.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief Example for running the low weight search on many codes in one process.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//  
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+
+#include "BatchSearch.h"
+#include "types.h"
+
+using namespace std;
+
+/*! \example batch.cpp
+    This is an example how to run many searches in one
+	process with BatchSearch.
+
+	The first argument is the manifest with one job per
+	line (see BatchSearch), e.g.
+
+	sha1-a sha1me.cm - - -i 500 -s 20
+	sha1-b sha1me.cm 0,1,2 - -i 500 -a stern -p 2
+
+	The optional second argument is the number of worker
+	threads, all cores are used by default. The code words
+	of each job are written to <name>.cw and the summary of
+	all jobs to <manifest>.summary.
+
+	\see search.cpp
+	\see shortening.cpp
+*/
+int main(int argc, const char* argv[]) {
+
+	// example: ./batch jobs.txt 4
+	if(argc != 2 && argc != 3) {
+		cout << "Usage: " << argv[0] << " <manifest> [threads]" << endl;
+		exit(-1);
+	}
+
+	string sManifest = argv[1];
+	uint64_t dThreads = argc == 3 ? strtoull(argv[2], NULL, 10) : 0;
+
+	BatchSearch oBatch;
+	if(!oBatch.ReadManifest(sManifest) || oBatch.GetJobs() == 0) {
+		cout << "Error: No jobs in " << sManifest << "." << endl;
+		exit(-1);
+	}
+
+	// run all jobs, failed jobs are marked in the summary
+	uint64_t dFailed = oBatch.Run(dThreads, sManifest + ".summary");
+
+	cout << "Finished " << oBatch.GetJobs() << " jobs, " << dFailed << " failed. The summary is in "
+	     << sManifest << ".summary." << endl;
+	return dFailed == 0 ? 0 : 1;
+}
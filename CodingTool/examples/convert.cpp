@@ -0,0 +1,79 @@
+/*!
+  \file convert.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief Example for converting code matrices between the text and the binary format.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//  
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+
+#include "CodeMatrix.h"
+#include "types.h"
+
+using namespace std;
+
+/*! \example convert.cpp
+    This is an example how to convert a code matrix
+	between the text format and the binary format.
+
+	It reads a matrix from the first file. If the file is
+	in the text format, it is written in the binary format
+	to the second file and vice versa. The binary file can
+	be used with the argument "-cm" like the text file,
+	but it is loaded without parsing.
+
+	\see search.cpp
+	\see sha1me.cpp
+*/
+int main(int argc, const char* argv[]) {
+
+	// example: ./convert sha1me.cm sha1me.cmb
+	if(argc != 3) {
+		cout << "Usage: " << argv[0] << " <input matrix> <output matrix>" << endl;
+		exit(-1);
+	}
+
+	string sInput  = argv[1];
+	string sOutput = argv[2];
+
+	// check the format of the input
+	bool bBinary = CodeMatrix::IsBinaryFile(sInput);
+
+	// read data from the file
+	CodeMatrix oMatrix;
+	oMatrix.ReadFromFile(sInput);
+
+	if(oMatrix.GetRows() == 0) {
+		cout << "Error: The matrix " << sInput << " is empty." << endl;
+		exit(-1);
+	}
+
+	// write the other format
+	if(bBinary)
+		oMatrix.PrintMatrix(sOutput);
+	else if(!oMatrix.WriteBinaryFile(sOutput))
+		exit(-1);
+
+	cout << "Converted " << oMatrix.GetRows() << "x" << oMatrix.GetColumns() << " matrix to the "
+	     << (bBinary ? "text" : "binary") << " format." << endl;
+	return 0;
+}
@@ -0,0 +1,128 @@
+/*!
+  \file coordinator.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief Example for a search with several processes.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <csignal>
+
+#include "SharedBoard.h"
+#include "CodeMatrix.h"
+#include "CodeWordFile.h"
+#include "InputHandler.h"
+#include "types.h"
+
+using namespace std;
+
+//! Set by SIGINT and SIGTERM, the workers are stopped.
+static volatile sig_atomic_t g_bInterrupted = 0;
+
+static void
+Interrupt(int iSignal) {
+	g_bInterrupted = 1;
+}
+
+/*! \example coordinator.cpp
+    This is an example how to run one search with several
+	processes on one host, e.g. one process per NUMA node.
+
+	The coordinator creates the shared memory board given by
+	"-bd" for the code matrix given by "-cm". Then the workers
+	are started with the same board, e.g.
+
+	./coordinator -cm sha1me.cm -bd sha1 -o sha1.cw -st 5
+	./search -cm sha1me.cm -bd sha1 -i 10000 -pc 1 -t 4 -sd 1
+	./search -cm sha1me.cm -bd sha1 -i 10000 -pc 1 -t 4 -sd 2
+
+	The workers discard candidates which are not better than
+	the minimum of all workers. The coordinator writes each
+	new minimum to the code word file given by "-o" and prints
+	the progress of all workers every "-st" seconds. It stops
+	when all workers are finished, Ctrl-C stops all workers.
+
+	\see search.cpp
+	\see SharedBoard
+*/
+int main(int argc, const char* argv[]) {
+
+	CodeMatrix   oMatrix;
+	CodeWord     oCodeWord;
+	Parameters   oParameters;
+	InputHandler oInputHandler(oParameters);
+	SharedBoard  oBoard;
+	CodeWordFile oOutput;
+	uint64_t     dGeneration = 0;
+
+	if(oInputHandler.ParseSettings(argc, argv))
+		exit(-1);
+
+	string sBoard = oParameters.GetStringParameter(Parameters::BOARD);
+	if(sBoard == "") {
+		cout << "Error: The name of the board is missing (-bd)." << endl;
+		exit(-1);
+	}
+
+	// only the length of the code is needed, a check matrix has the same length
+	oMatrix.ReadFromFile(oParameters.GetStringParameter(Parameters::CMFILE));
+	if(!oBoard.Create(sBoard, oMatrix.GetColumns()))
+		exit(-1);
+
+	oOutput.SetParameters(oParameters);
+	oOutput.SetBinary(oParameters.GetIntegerParameter(Parameters::BINARYCW) != 0);
+	if(!oOutput.Write(oParameters.GetStringParameter(Parameters::OUTPUT)))
+		exit(-1);
+
+	signal(SIGINT, Interrupt);
+	signal(SIGTERM, Interrupt);
+	cout << "Info: Board " << sBoard << " created, start the workers with -bd " << sBoard << endl;
+
+	uint64_t dInterval = oParameters.GetIntegerParameter(Parameters::STATISTICSTIME);
+	chrono::steady_clock::time_point tPrint = chrono::steady_clock::now() + chrono::seconds(dInterval);
+	bool bFinished = false;
+	while(!bFinished) {
+		this_thread::sleep_for(chrono::milliseconds(100));
+		if(g_bInterrupted && !oBoard.IsStopped()) {
+			cout << "Info: Stopping the workers" << endl;
+			oBoard.Stop();
+		}
+		bFinished = oBoard.IsFinished();
+
+		// each new minimum of the workers is written once
+		if(oBoard.GetGeneration() != dGeneration) {
+			dGeneration = oBoard.GetBest(oCodeWord);
+			oOutput.WriteCodeWord(oCodeWord);
+			oOutput.Flush();
+		}
+		if(bFinished || chrono::steady_clock::now() >= tPrint) {
+			oBoard.Print(cout);
+			tPrint = chrono::steady_clock::now() + chrono::seconds(dInterval);
+		}
+	}
+
+	if(oCodeWord.GetLength() > 0) {
+		oCodeWord.Print64();
+		cout << "Hamming weight is " << oBoard.GetBestWeight() << endl;
+	}
+	return 0;
+}
@@ -43,7 +43,19 @@ using namespace std;
 	should find the Hamming weight of 25 after few iterations.
 	Using the argument "-pc 1" which enables random permutaion
 	of the columns, results in feewer needed iterations.
+	The argument "-a" selects the search algorithm, e.g.
+	"-a stern -p 2" or "-a mmt -p 4 -s 24".
+	With "-cp search.ckp" the state is saved periodically,
+	an interrupted search continues with "-r search.ckp".
+	With "-sf search.csv -st 5" the counters and timers of the
+	search are written every 5 seconds, e.g. to choose sigma and p.
+	"-sd 42" fixes the seed, a run with one chain can be repeated.
+	With "-hm 1" the file contains a parity-check matrix, which
+	is searched directly (see LowWeightSearch::SearchCheck).
+	With "-bd name" the process is a worker of the board created
+	by the coordinator example, several processes search together.
 
+	\see coordinator.cpp
 	\see sha1me.cpp
 */
 int main(int argc, const char* argv[]) {
@@ -71,8 +83,20 @@ int main(int argc, const char* argv[]) {
 
 	// read data from the file
 	oGenerator.ReadFromFile(sCMFile);
-	// start the search
-	oCodeWord = oLowWS.CanteautChabaud(oGenerator,oParameters);
+	// join the multi-process search of the coordinator
+	SharedBoard oBoard;
+	string sBoard = oParameters.GetStringParameter(Parameters::BOARD);
+	if(sBoard != "") {
+		if(!oBoard.Attach(sBoard, oGenerator.GetColumns()))
+			exit(-1);
+		oLowWS.SetBoard(&oBoard);
+	}
+
+	// start the search with the algorithm given by "-a"
+	if(oParameters.GetIntegerParameter(Parameters::CHECKMATRIX))
+		oCodeWord = oLowWS.SearchCheck(oGenerator,oParameters);
+	else
+		oCodeWord = oLowWS.Search(oGenerator,oParameters);
 
 	// print the code word and the Hamming weight
 	oCodeWord.Print64();
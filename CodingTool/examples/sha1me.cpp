@@ -30,17 +30,10 @@
 #include "LowWeightSearch.h"
 #include "InputHandler.h"
 #include "types.h"
+#include "sha1me.h"
 
 using namespace std;
 
-//! Rotate a 32-bit word to the right.
-# define ROTR(w,x) ((((w) & 0xFFFFFFFF) >> (x))|((w) << (32 - (x))))
-//! Rotate a 32-bit word to the left.
-# define ROTL(w,x) (((w) << (x))|(((w) & 0xFFFFFFFF) >> (32 - (x)))) 
-
-CodeWord BuildFunction(uint64_t & dIter);
-void SHA1ME(uint32_t * m);
-
 /*! \example sha1me.cpp
 
     This is an example for creating a code matrix.
@@ -68,37 +61,3 @@ int main(int argc, const char* argv[]) {
 
 	exit(1);
 }
-
-CodeWord BuildFunction(uint64_t & i) {
-
-	CodeWord oCodeWord;
-	uint32_t m[60];
-	uint32_t unitv = 1;
-
-	// 512 bit message block
-	for(uint32_t j = 0; j<16; j++)
-		m[j] = 0;
-
-	// create i-th unit vector for the input
-	unitv = ROTR(unitv , i+1);
-	
-	// set input to i-th unit vector
-	m[i/32] = unitv;
-
-	// call the message expansion
-	SHA1ME(m);
-
-	// add message to the code
-	for(uint32_t j = 0; j<60; j++)
-		oCodeWord.Push32(m[j]);
-	
-	return oCodeWord;
-}
-
-
-void SHA1ME(uint32_t * m) {
-
-	// SHA-1 message expansion for the last 60 words
-	for(uint32_t j = 16; j<60; j++)
-		m[j] = ROTL((m[j-3] ^ m[j-8] ^ m[j-14] ^ m[j-16]),1);
-}
\ No newline at end of file
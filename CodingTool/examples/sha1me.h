@@ -0,0 +1,78 @@
+/*!
+  \file sha1me.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief The SHA-1 message expansion code of sha1me.cpp.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef SHA1ME_H_
+#define SHA1ME_H_
+
+#include "CodeWord.h"
+#include "types.h"
+
+//! Rotate a 32-bit word to the right.
+# define ROTR(w,x) ((((w) & 0xFFFFFFFF) >> (x))|((w) << (32 - (x))))
+//! Rotate a 32-bit word to the left.
+# define ROTL(w,x) (((w) << (x))|(((w) & 0xFFFFFFFF) >> (32 - (x))))
+
+//! Computes the SHA-1 message expansion.
+/*!
+  \param m The 16 words of the message block, the words 16 to 59 are written.
+*/
+inline void SHA1ME(uint32_t * m) {
+
+	// SHA-1 message expansion for the last 60 words
+	for(uint32_t j = 16; j<60; j++)
+		m[j] = ROTL((m[j-3] ^ m[j-8] ^ m[j-14] ^ m[j-16]),1);
+}
+
+//! Returns row i of the 512x1920 SHA-1 message expansion code.
+/*!
+  The row is the expansion of the i-th unit vector, it is
+  used with CodeMatrix::Build.
+  \param i The index of the row.
+  \return The code word of the row.
+*/
+inline CodeWord BuildFunction(uint64_t & i) {
+
+	CodeWord oCodeWord;
+	uint32_t m[60];
+	uint32_t unitv = 1;
+
+	// 512 bit message block
+	for(uint32_t j = 0; j<16; j++)
+		m[j] = 0;
+
+	// create i-th unit vector for the input
+	unitv = ROTR(unitv , i+1);
+
+	// set input to i-th unit vector
+	m[i/32] = unitv;
+
+	// call the message expansion
+	SHA1ME(m);
+
+	// add message to the code
+	for(uint32_t j = 0; j<60; j++)
+		oCodeWord.Push32(m[j]);
+
+	return oCodeWord;
+}
+
+#endif
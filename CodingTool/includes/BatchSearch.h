@@ -0,0 +1,180 @@
+/*!
+  \file BatchSearch.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class BatchSearch.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef BATCHSEARCH_H_
+#define BATCHSEARCH_H_
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+#include "types.h"
+#include "CodeMatrix.h"
+#include "CodeWord.h"
+#include "Parameters.h"
+#include "InputHandler.h"
+#include "LowWeightSearch.h"
+
+//! Runs low weight searches on many codes in one process.
+/*!
+  A batch is described by a manifest file. Each line describes one
+  job, empty lines and lines starting with '#' are ignored:\n\n
+  name matrix columns weights [arguments]\n\n
+  - name: the name of the job, the code words are written to name.cw
+  - matrix: the file of the generator matrix (see CodeMatrix::ReadFromFile)
+  - columns: comma separated columns which are forced to zero by
+    LowWeightSearch::CodeShortening, or - for none
+  - weights: a file with the weight of each bit (see
+    LowWeightSearch::SetWeightVector), or - for none
+  - arguments: the arguments of the search as on the command line,
+    e.g. -i 1000 -s 22 -a stern (see InputHandler)
+
+  The jobs are run by a pool of worker threads. Each worker has its own
+  queue of jobs and takes jobs from the queues of the other workers if
+  its queue is empty. Each matrix file is read only once, and jobs with
+  the same matrix and columns share the shortened matrix and its
+  systematic form (LowWeightSearch::SetSystematicForm). By default a
+  job runs one search chain (Parameters::THREADS) and does not print
+  the iterations (Parameters::DOUTPUT), the manifest can change that.\n\n
+  After all jobs the summary is written, one line per job with the name,
+  the matrix, the Hamming weight of the code word found and the time in
+  seconds. If the job has weights, the weighted Hamming weight is written
+  as the search minimized it. The weight is - if the job failed.
+
+  \see LowWeightSearch
+*/
+class BatchSearch {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	BatchSearch(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~BatchSearch(void);
+
+	//! Reads the jobs from a manifest file.
+	/*!
+	  \param sFileName The manifest file.
+	  \return False if the file can not be read or a line is invalid,
+	          an error is printed.
+	*/
+	bool ReadManifest(const std::string & sFileName);
+
+	//! Runs all jobs.
+	/*!
+	  \param dThreads Number of worker threads, 0 uses all cores.
+	  \param sSummary The file of the summary.
+	  \return The number of failed jobs.
+	*/
+	uint64_t Run(uint64_t dThreads, const std::string & sSummary);
+
+	//! Returns the number of jobs.
+	uint64_t GetJobs() const;
+
+private:
+	//! A job of the manifest.
+	struct Job {
+		std::string           sName;      //!< The name of the job.
+		std::string           sMatrix;    //!< The file of the generator matrix.
+		std::vector<uint64_t> vColumns;   //!< The columns forced to zero.
+		std::string           sWeights;   //!< The file of the weight vector.
+		std::vector<std::string> vArguments; //!< The arguments of the search.
+		std::string           sKey;       //!< Jobs with the same key share the preprocessing.
+
+		bool                  bDone;      //!< True if the job was run.
+		uint64_t              dWeight;    //!< The (weighted) Hamming weight of the code word found.
+		double                dSeconds;   //!< The run time of the job.
+	};
+
+	//! The queue of a worker.
+	struct Queue {
+		std::mutex            oMutex;     //!< Protects the queue.
+		std::deque<uint64_t>  dJobs;      //!< Indices of the jobs.
+	};
+
+	//! The preprocessing shared by jobs with the same key.
+	struct Code {
+		std::mutex            oMutex;     //!< Protects the members below.
+		bool                  bReady;     //!< True if the preprocessing is done.
+		bool                  bValid;     //!< False if the matrix can not be read.
+		CodeMatrix            oGenerator; //!< The (shortened) generator matrix.
+		LowWeightSearch::SystematicForm oForm; //!< The systematic form of oGenerator.
+	};
+
+	//! Runs jobs until all queues are empty.
+	/*!
+	  \param dWorker The index of the worker.
+	*/
+	void Work(uint64_t dWorker);
+
+	//! Takes a job from the queue of the worker or from another queue.
+	/*!
+	  \param dWorker The index of the worker.
+	  \param dJob Returns the index of the job.
+	  \return False if all queues are empty.
+	*/
+	bool NextJob(uint64_t dWorker, uint64_t & dJob);
+
+	//! Runs one job.
+	/*!
+	  \param oJob The job.
+	*/
+	void RunJob(Job & oJob);
+
+	//! Returns the preprocessed code of a job.
+	/*!
+	  The code is prepared by the first job which needs it, other jobs
+	  wait until it is ready.
+	  \param oJob The job.
+	  \return The code.
+	*/
+	Code & GetCode(Job & oJob);
+
+	//! Returns a matrix file, each file is read only once.
+	/*!
+	  \param sFileName The file.
+	  \param oMatrix Returns the matrix.
+	*/
+	void GetMatrix(const std::string & sFileName, CodeMatrix & oMatrix);
+
+	std::vector<Job>                    m_vJobs;      //!< The jobs.
+	std::vector<Queue*>                 m_vQueues;    //!< The queue of each worker.
+	std::map<std::string, Code*>        m_mCodes;     //!< The preprocessed codes.
+	std::map<std::string, CodeMatrix*>  m_mMatrices;  //!< The matrix files.
+	std::mutex                          m_oMutex;     //!< Protects the maps and the output.
+};
+
+#endif
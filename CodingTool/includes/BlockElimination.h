@@ -0,0 +1,191 @@
+/*!
+  \file BlockElimination.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class BlockElimination.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef BLOCKELIMINATION_H_
+#define BLOCKELIMINATION_H_
+
+#include <vector>
+
+#include "types.h"
+#include "MatrixStorage.h"
+#include "ColumnGather.h"
+#include "CodeMatrix.h"
+
+//! Gaussian elimination over GF(2) with the Method of Four Russians.
+/*!
+  The pivot columns are processed in blocks of k columns. For a block,
+  the k pivot rows are searched on the k-bit projections of the rows
+  onto the block columns, such that only the pivot rows themselves are
+  changed. Then a table of all 2^k linear combinations of the pivot rows
+  is built in Gray code order (one row addition per entry) and every
+  other row is reduced with one table lookup and one row addition.
+  The table is applied in column stripes which fit into the cache.\n\n
+  Rows are never moved, the order of the rows is kept in a permutation.
+  A second matrix can be attached to the rows, to which the same row
+  operations are applied (e.g. an identity matrix to record the
+  performed operations).\n\n
+  The class is used by LowWeightSearch::GaussMod2 and
+  LowWeightSearch::CodeShortening.
+
+  \see LowWeightSearch
+*/
+class BlockElimination {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	BlockElimination(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~BlockElimination(void);
+
+	//! Copies the matrix into the engine.
+	/*!
+	  \param oMatrix The matrix.
+	  \param pAttached A matrix with the same number of rows to which the
+	                   same row operations are applied, or NULL.
+	*/
+	void Load(CodeMatrix & oMatrix, CodeMatrix * pAttached = NULL);
+
+	//! Sets the number of columns processed at once.
+	/*!
+	  \param dBlockSize The block size k, at most BlockElimination::MAXBLOCK.
+	                    If 0, k is chosen from the number of rows.
+	*/
+	void SetBlockSize(uint32_t dBlockSize);
+
+	//! Eliminates the given columns.
+	/*!
+	  For each column a pivot row is searched among the rows which are
+	  not yet pivot rows, and the column is cleared in all other rows.
+	  The pivot rows are moved to the front of the row order.
+	  \param vColumns The columns in the order in which they are eliminated.
+	  \param bStable If true, the first row in the current order with a one
+	                 is the pivot and the order of the other rows is kept.
+	                 Otherwise the pivot row is exchanged with the row at the
+	                 pivot position.
+	  \param bSwapColumns If true, vColumns has to be 0,1,2,... and row i
+	                      becomes the pivot of column i. If no pivot is found,
+	                      the column is exchanged with the first following
+	                      column in which row i has a one (as in the textbook
+	                      Gauss-Jordan algorithm).
+	  \return The number of pivot rows (the rank of the eliminated columns).
+	*/
+	uint64_t Eliminate(const std::vector<uint64_t> & vColumns, bool bStable, bool bSwapColumns);
+
+	//! Returns rows of the matrix.
+	/*!
+	  \param oMatrix The matrix for the result.
+	  \param dFirst Position of the first row in the current row order.
+	*/
+	void GetRows(CodeMatrix & oMatrix, uint64_t dFirst);
+
+	//! Returns rows of the matrix restricted to some columns.
+	/*!
+	  \param oMatrix The matrix for the result.
+	  \param dFirst Position of the first row in the current row order.
+	  \param vColumns The columns which are returned.
+	*/
+	void GetRows(CodeMatrix & oMatrix, uint64_t dFirst, const std::vector<uint64_t> & vColumns);
+
+	//! Returns the attached matrix in the current row order.
+	/*!
+	  \param oMatrix The matrix for the result.
+	*/
+	void GetAttached(CodeMatrix & oMatrix);
+
+	//! Returns the column permutation.
+	/*!
+	  Entry i is the original index of the column at position i.
+	  Columns are only exchanged if bSwapColumns is set.
+	  \return The permutation.
+	*/
+	const std::vector<uint64_t> & GetColumnPermutation() const;
+
+	static const uint32_t MAXBLOCK = 10; //!< Largest supported block size.
+
+private:
+	//! A pivot row of the current block.
+	struct Pivot {
+		uint64_t dRow;   //!< Index of the row in the storage.
+		uint64_t dProj;  //!< Projection of the row onto the block columns.
+		uint64_t dBit;   //!< The bit of the pivot column in the projection.
+	};
+
+	//! Adds row dSrc to row dDst, starting at m_dFirstWord.
+	void XorRow(uint64_t dDst, uint64_t dSrc);
+
+	//! Reduces a row by the pivots of the current block.
+	/*!
+	  \param dRow Index of the row in the storage.
+	  \param vPivots The pivots of the current block.
+	*/
+	void ReduceRow(uint64_t dRow, const std::vector<Pivot> & vPivots);
+
+	//! Computes the projections of all rows onto the block columns.
+	void Project(const ColumnGather & oGather);
+
+	//! Exchanges two columns in all rows.
+	/*!
+	  The projections are updated as well.
+	  \param dCol1 The first column.
+	  \param dCol2 The second column.
+	  \param dProj1 The bit of the first column in the projections or 0.
+	  \param dProj2 The bit of the second column in the projections or 0.
+	*/
+	void SwapColumns(uint64_t dCol1, uint64_t dCol2, uint64_t dProj1, uint64_t dProj2);
+
+	//! Returns the first column >= dFrom in which a row has a one.
+	/*!
+	  \return The column or m_dColumns if there is none.
+	*/
+	uint64_t FindColumn(uint64_t dRow, uint64_t dFrom);
+
+	//! Builds the table of the combinations of the pivots and reduces all other rows.
+	/*!
+	  \param vPivots The pivots of the current block.
+	  \param dBlockSize Number of columns of the current block.
+	*/
+	void ReduceBlock(const std::vector<Pivot> & vPivots, uint32_t dBlockSize);
+
+	//! Copies rows into a CodeMatrix.
+	void Store(CodeMatrix & oMatrix, uint64_t dFirst, uint64_t dWord, uint64_t dColumns);
+
+	MatrixStorage         m_oData;        //!< The rows, the attached matrix follows in each row.
+	MatrixStorage         m_oTable;       //!< The table of the pivot combinations.
+	std::vector<uint64_t> m_vOrder;       //!< Maps positions to rows of m_oData.
+	std::vector<uint64_t> m_vColsPerm;    //!< The column permutation.
+	std::vector<uint64_t> m_vProj;        //!< Projections of the rows onto the block columns.
+	std::vector<uint32_t> m_vIndex;       //!< Table index of each row.
+	uint64_t              m_dColumns;     //!< Number of columns of the matrix.
+	uint64_t              m_dWords;       //!< Number of 64-bit words of the matrix.
+	uint64_t              m_dAttached;    //!< Number of columns of the attached matrix.
+	uint64_t              m_dFirstWord;   //!< First word which can be nonzero in a pivot row.
+	uint32_t              m_dBlockSize;   //!< The block size k, 0 for automatic.
+};
+
+#endif
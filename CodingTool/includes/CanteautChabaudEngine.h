@@ -0,0 +1,78 @@
+/*!
+  \file CanteautChabaudEngine.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class CanteautChabaudEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CANTEAUTCHABAUDENGINE_H_
+#define CANTEAUTCHABAUDENGINE_H_
+
+#include "types.h"
+#include "IsdEngine.h"
+
+//! The collision search of the algorithm by Canteaut and Chabaud.
+/*!
+  The rows of Z are split into two halves Z1 and Z2. All combinations
+  of 1 up to p rows of each half are projected onto a random window
+  of sigma columns, and combinations of Z1 and Z2 with the same
+  projection are candidates, where each combination of Z2 is only
+  combined with the last combination of Z1 with the same projection.
+  Together with Delta Gauss this is the algorithm of
+  LowWeightSearch::CanteautChabaud, p = 2 (the default of
+  Parameters::P) are the single rows and pairs of the original
+  algorithm. Larger p need larger sigma, the lists have about
+  (k/2)^p/p! entries.
+
+  \see IsdEngine
+*/
+class CanteautChabaudEngine : public IsdEngine {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	CanteautChabaudEngine(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~CanteautChabaudEngine(void);
+
+	//! Returns a new engine with the same parameters.
+	virtual IsdEngine * Clone() const;
+
+	//! Returns the name of the engine.
+	virtual const char * GetName() const;
+
+	//! Runs one iteration.
+	/*!
+	  \param oZ The Z part of the systematic generator matrix.
+	  \param oRnGen The random number generator of the chain.
+	  \param oCallback Receives the candidates.
+	*/
+	virtual void Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback);
+
+private:
+	IsdEngine::CombinationList m_oList1;  //!< The combinations of Z1.
+	IsdEngine::CombinationList m_oList2;  //!< The combinations of Z2.
+};
+
+#endif
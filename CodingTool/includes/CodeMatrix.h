@@ -33,19 +33,24 @@
 
 #include "types.h"
 #include "CodeWord.h"
+#include "MatrixStorage.h"
+#include "ColumnGather.h"
+#include "WeightTable.h"
 
 //! This class represents a binary code matrix.
 /*! 
-  The data structure consists of a STL vector containing instances of the 
-  class CodeWord. Each row of the matrix is one code word. Therefore,
-  the data is stored in 64-bit or 32-bit words, depending on 
-  the target architecture. Data can be added and accessed in different ways
+  The data of all rows is stored in one contiguous block (see MatrixStorage)
+  with a fixed stride of 64-bit words per row. Each row of the matrix is
+  exposed as a CodeWord which is a view of the corresponding part of the
+  block. Therefore, row operations like CodeWord::operator^= work directly
+  on the matrix data. Data can be added and accessed in different ways
   (see CodeWord). The matrix can be considered as a bit, 32-bit word or
   64-bit word matrix (little endian). 
   The number of rows or columns refers to the bit representation of the matrix,
   since it represents code dimension and length.
 
   \see CodeWord
+  \see MatrixStorage
 */
 class CodeMatrix {
 public:
@@ -55,6 +60,21 @@ public:
 	*/
 	CodeMatrix(void);
 
+	//! Copy constructor.
+	/*!
+	  Does a deep copy of the matrix.
+	  \param oM The matrix to copy.
+	*/
+	CodeMatrix(const CodeMatrix & oM);
+
+	//! Move constructor.
+	/*!
+	  Takes the data of the other matrix, which is empty afterwards.
+	  References to the rows stay valid and refer to the new matrix.
+	  \param oM The matrix to move.
+	*/
+	CodeMatrix(CodeMatrix && oM) noexcept;
+
 	//! Destructor.
 	/*!
 	  Does nothing special.
@@ -77,10 +97,32 @@ public:
       If the matrix is not empty the length of the added code word
 	  has to be the same as the current length of the matrix. If it is not
 	  an error message is printed to the console and the code word is not
-	  added.
+	  added. The data of the code word is copied into the matrix. References
+	  to rows obtained by CodeMatrix::operator[] may be invalid afterwards.
 	  \param oRow The code word which should be added.
 	*/
-	void AddRow(CodeWord oRow);
+	void AddRow(const CodeWord & oRow);
+
+	//! Reserves memory for the given number of rows.
+	/*!
+	  Adding rows up to this number does not allocate memory. The number
+	  of columns has to be known, i.e. the matrix has at least one row.
+	  References to rows obtained by CodeMatrix::operator[] may be
+	  invalid afterwards.
+	  \param dRows Number of rows.
+	*/
+	void Reserve(uint64_t dRows);
+
+	//! Changes the shape of the matrix.
+	/*!
+	  If the number of columns does not change, the first rows are kept
+	  and new rows are zero. Otherwise a zero matrix is created. The
+	  memory is only reallocated if it is too small. References to rows
+	  obtained by CodeMatrix::operator[] may be invalid afterwards.
+	  \param dRows The new number of rows.
+	  \param dColumns The new number of columns.
+	*/
+	void Resize(uint64_t dRows, uint64_t dColumns);
 
 	//! Returns a submatrix of the current matrix.
 	/*!
@@ -92,7 +134,73 @@ public:
 	               in the new matrix.
       \return The submatrix fo the current matrix.
 	*/
-	CodeMatrix GetSubMatrix(std::vector<uint64_t> & vRows, std::vector<uint64_t> & vCols);
+	CodeMatrix GetSubMatrix(const std::vector<uint64_t> & vRows, const std::vector<uint64_t> & vCols) const;
+
+	//! Computes a submatrix of the current matrix.
+	/*!
+      Same as above, but the columns are given by a precomputed
+	  ColumnGather and the result is written to oSubMatrix, whose
+	  memory is reused. This is the fast variant for repeated calls.
+	  \param vRows The indices of the rows which should be included
+	               in the new matrix.
+      \param oGather The columns which should be included in the new matrix.
+      \param oSubMatrix The submatrix of the current matrix.
+	*/
+	void GetSubMatrix(const std::vector<uint64_t> & vRows, const ColumnGather & oGather, CodeMatrix & oSubMatrix) const;
+
+	//! Returns consecutive rows of the matrix as a view.
+	/*!
+      No data is copied, oView refers to the memory of the current
+	  matrix. Changes of the bits are visible in both matrices, but the
+	  Hamming weights stored in the current matrix are not updated.
+	  Rows can not be added to or deleted from a view. A copy of
+	  the view is an ordinary matrix. The view is invalid if rows
+	  are added to or deleted from the current matrix.
+	  \param dFirst Index of the first row.
+	  \param dRows Number of rows.
+	  \param oView The view.
+	*/
+	void GetRowRange(uint64_t dFirst, uint64_t dRows, CodeMatrix & oView);
+
+	//! Returns the Hamming weight of the sum of some rows.
+	/*!
+	  The sum is computed word by word in one pass (see RowsXorWeight),
+	  no code word is created and the matrix is not changed. The
+	  computation stops as soon as the weight reaches the bound.
+	  \param pRows The row indices.
+	  \param dRows Number of rows, at most MAXXORROWS.
+	  \param dBound The bound.
+	  \return The Hamming weight of the sum if it is smaller than dBound,
+	          otherwise a value which is at least dBound.
+	*/
+	uint64_t XorWeight(const uint64_t * pRows, uint32_t dRows, uint64_t dBound = UINT64_MAX) const;
+
+	//! Returns the weighted Hamming weight of the sum of some rows.
+	/*!
+	  The bits are weighted by a WeightTable, the weight of each word is
+	  computed with a few masked popcounts or table lookups. The bound is
+	  checked every ROWCHUNK words.
+	  \param pRows The row indices.
+	  \param dRows Number of rows, at most MAXXORROWS.
+	  \param oWeights The weights of the columns.
+	  \param dBound The bound.
+	  \return The weighted Hamming weight of the sum if it is smaller than dBound,
+	          otherwise a value which is at least dBound.
+	*/
+	uint64_t XorWeight(const uint64_t * pRows, uint32_t dRows, const WeightTable & oWeights,
+	                   uint64_t dBound = UINT64_MAX) const;
+
+	//! Adds a pivot row to all rows with a one in the pivot column.
+	/*!
+	  The pivot column is extracted into vColumn, bit i%64 of vColumn[i/64]
+	  is the element of row i. The pivot row is added in place to exactly
+	  the selected rows, and the bit of the pivot column is kept (it is one
+	  in all selected rows). This is the step of LowWeightSearch::DeltaGauss.
+	  \param dRow The pivot row, its element in dColumn must be one.
+	  \param dColumn The pivot column.
+	  \param vColumn Returns the pivot column.
+	*/
+	void Pivot(uint64_t dRow, uint64_t dColumn, std::vector<uint64_t> & vColumn);
 
 	//! Returns the bit at the given position.
 	/*!
@@ -171,6 +279,23 @@ public:
 	*/
 	void DeleteRow(uint64_t dRow);
 
+	//! Exchanges two rows of the matrix.
+	/*!
+	  The data is exchanged in place, the views of the rows
+	  keep their position.
+	  \param dRow1 The index of the first row.
+	  \param dRow2 The index of the second row.
+	*/
+	void SwapRows(uint64_t dRow1, uint64_t dRow2);
+
+	//! Exchanges the data of two matrices.
+	/*!
+	  No data is copied. References to the rows stay valid
+	  and refer to the other matrix afterwards.
+	  \param oM The other matrix.
+	*/
+	void Swap(CodeMatrix & oM) noexcept;
+
 	//! Deletes a column of the matrix.
 	/*!
 	  This method deletes the specified column.
@@ -180,6 +305,17 @@ public:
 	*/
 	void DeleteColumn(uint64_t dColumn);
 
+	//! Permutes the columns of the matrix.
+	/*!
+	  Column i of the permuted matrix is column vPerm[i] of the matrix.
+	  The rows are processed in blocks of 64 rows. The blocks are
+	  transposed 64x64 bits at a time, such that whole columns are moved
+	  as 64-bit words instead of single bits. The Hamming weights of the
+	  rows do not change.
+	  \param vPerm The permutation, it contains each column once.
+	*/
+	void PermuteColumns(const std::vector<uint64_t> & vPerm);
+
 	//! Returns the number of rows.
 	/*!
 	  \return The number of rows.
@@ -215,11 +351,63 @@ public:
 	/*!
       This method reads data from the given file and
 	  creates the matrix. The matrix has to be
-	  in the same format as specified by PrintMatrix.
+	  in the same format as specified by PrintMatrix
+	  or in the binary format of WriteBinaryFile.
 	  \param sFileName The filename containing data.
 	*/
 	void ReadFromFile(const std::string & sFileName);
 
+	//! Writes the matrix in the binary format.
+	/*!
+	  The file starts with a header of CodeMatrix::BINARYHEADER bytes,
+	  containing the magic "CTMATRIX", the format version, the number of
+	  rows, columns and the stride (64-bit words between two rows).
+	  Then the rows follow as 64-bit words with the given stride and
+	  at last the Hamming weight of each row. All numbers are written
+	  in the byte order of the machine.
+	  \param sFileName The filename.
+	  \return Returns true if the file was written, otherwise false.
+	*/
+	bool WriteBinaryFile(const std::string & sFileName);
+
+	//! Reads a matrix in the binary format.
+	/*!
+	  If possible, the file is mapped into memory and the rows are used
+	  without parsing or copying. Pages of the file are only read when
+	  the rows are accessed, changes of the matrix are not written back.
+	  Otherwise the rows are read into allocated memory.
+	  \param sFileName The filename.
+	  \return Returns true if the matrix was read, otherwise false.
+	*/
+	bool ReadBinaryFile(const std::string & sFileName);
+
+	//! Writes the matrix in the binary format to a stream.
+	/*!
+	  The format is the same as in WriteBinaryFile, the stream may
+	  contain other data before and after the matrix.
+	  \param oStream The stream.
+	  \return Returns true if the matrix was written, otherwise false.
+	*/
+	bool WriteBinary(std::ostream & oStream);
+
+	//! Reads a matrix in the binary format from a stream.
+	/*!
+	  The matrix starts at the current position of the stream, after
+	  the call the position is behind the matrix. The rows are always
+	  read into allocated memory.
+	  \param oStream The stream.
+	  \return Returns true if the matrix was read, otherwise false.
+	*/
+	bool ReadBinary(std::istream & oStream);
+
+	//! Returns true if the file is in the binary format.
+	/*!
+	  Only the magic at the start of the file is checked.
+	  \param sFileName The filename.
+	  \return Returns true if the file starts with "CTMATRIX".
+	*/
+	static bool IsBinaryFile(const std::string & sFileName);
+
 	//! Returns true if the matrix is a systematic generator matrix.
 	/*!
 	  \return Returns true if matrix is systematic, otherwise false.
@@ -228,7 +416,8 @@ public:
 
 	//! Returns the transposed matrix.
 	/*!
-	  This method considers the matrix as binary.
+	  This method considers the matrix as binary. The matrix is
+	  transposed in blocks of 64x64 bits (see CodeMatrix::Transpose64).
       \return The transposed matrix.
 	*/
 	CodeMatrix Transpose();	
@@ -241,18 +430,67 @@ public:
 	*/
 	CodeMatrix & operator=(const CodeMatrix& oM);
 
+	//! Overloads the move assignment operator.
+	/*!
+      The data of oM is taken, oM is empty afterwards.
+	  \param oM The right hand side of the assignment.
+	  \return The left hand side of the assignment.
+	*/
+	CodeMatrix & operator=(CodeMatrix && oM) noexcept;
+
 	//! Returns one row of the matrix.
 	/*!
       This method returns a reference of the specified
 	  code word, which represents a row of the matrix.
+	  The code word is a view of the matrix data and
+	  cannot change its length.
 	  \param dIndex The row index.
 	  \return The reference to the code word.
 	*/
 	CodeWord & operator[](uint64_t dIndex);
 
+	static const uint32_t BINARYVERSION = 1;  //!< Version of the binary format.
+	static const uint32_t BINARYHEADER  = 64; //!< Size of the binary header in bytes.
+
 private:
+	friend class BlockElimination;
+
+	//! The header of the binary format.
+	struct BinaryHeader {
+		char     aMagic[8];    //!< "CTMATRIX".
+		uint32_t dVersion;     //!< Version of the format.
+		uint32_t dHeaderSize;  //!< Size of the header in bytes.
+		uint64_t dRows;        //!< Number of rows.
+		uint64_t dColumns;     //!< Number of columns.
+		uint64_t dStride;      //!< Number of 64-bit words between two rows.
+		uint64_t dByteOrder;   //!< 0x0102030405060708 in the byte order of the writer.
+		uint64_t dReserved[2]; //!< Zero.
+	};
+
+	//! Creates a zero matrix.
+	/*!
+	  All data is discarded.
+	  \param dRows Number of rows.
+	  \param dColumns Number of columns.
+	*/
+	void Allocate(uint64_t dRows, uint64_t dColumns);
+
+	//! Transposes a 64x64 bit matrix in place.
+	/*!
+	  Bit 63-j of word i is the entry (i,j).
+	  \param pBlock The 64 words of the matrix.
+	*/
+	static void Transpose64(uint64_t * pBlock);
+
+	//! Points the row views to the current storage.
+	/*!
+	  \param dFirst Index of the first row which has to be updated.
+	*/
+	void RebindRows(uint64_t dFirst = 0);
 
-	std::vector<CodeWord> m_oData;  //!< The matrix data.
+	MatrixStorage         m_oStorage;  //!< The matrix data.
+	std::vector<CodeWord> m_oData;     //!< Views of the rows of m_oStorage.
+	uint64_t              m_dColumns;  //!< Number of columns.
 
 };
 
@@ -28,10 +28,12 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <cstring>
 #include <cassert>
 
 #include "types.h"
 #include "HammingWeight.h"
+#include "RowKernels.h"
 
 //! This class represents a binary code word.
 /*! 
@@ -39,7 +41,11 @@
   32-bit or 64-bit words, depending on the target architecture.
   Data can be added and accessed in different ways. A code word 
   can be considered as a bit, 32-bit word or 64-bit word (little endian). 
-  The length of a code word refers to the bit representation.
+  The length of a code word refers to the bit representation.\n\n
+  A code word can also be a view of a row of a CodeMatrix. In that case
+  the data is owned by the matrix and the code word cannot grow. Methods
+  which shrink the code word operate in place. A copy of a view is an
+  ordinary code word owning its data.
 */
 class CodeWord {
 public:
@@ -49,6 +55,25 @@ public:
 	*/
 	CodeWord(void);
 
+	//! Copy constructor.
+	/*!
+	  Does a deep copy of the object. The new code word always
+	  owns its data.
+	  \param oCodeWord The code word to copy.
+	*/
+	CodeWord(const CodeWord & oCodeWord);
+
+	//! Move constructor.
+	/*!
+	  Takes the data of the other code word, which is empty afterwards.
+	  If the other code word is a view, the new code word is a view of
+	  the same data and no memory is allocated. This is used if the rows
+	  of a CodeMatrix are moved, the matrix rebinds the views if its
+	  storage changes.
+	  \param oCodeWord The code word to move.
+	*/
+	CodeWord(CodeWord && oCodeWord) noexcept;
+
 	//! Destructor.
 	/*!
 	  Does nothing special.
@@ -63,7 +88,8 @@ public:
 
 	//! Returns the Hamming weight where bits are weighted differently.
 	/*!
-      \param vWeights Contains the weight for each bit of the code word.
+      \param vWeights Contains the weight for each bit of the code word,
+	                  vWeights[i] is the weight of bit i.
 	  \return The weighted Hamming weight.
 	*/
 	uint64_t GetHammingWeight(std::vector<uint64_t> & vWeights) const;
@@ -224,6 +250,29 @@ public:
 	*/
 	void Clear();
 
+	//! Reserves memory for the given length.
+	/*!
+	  Pushing bits up to this length does not allocate memory.
+	  \param dLength The length in bits.
+	*/
+	void Reserve(uint64_t dLength);
+
+	//! Changes the length of the code word.
+	/*!
+	  New bits are zero, the memory is kept if the code word gets shorter.
+	  \param dLength The new length in bits.
+	*/
+	void Resize(uint64_t dLength);
+
+	//! Exchanges the data of two code words.
+	/*!
+	  If one of the code words is a view, both have to have the
+	  same length and the data is exchanged word by word. Otherwise
+	  only the memory is exchanged.
+	  \param oCodeWord The other code word.
+	*/
+	void Swap(CodeWord & oCodeWord);
+
 	//! Outputs the code word bit-wise
 	/*!
       This method writes the code word to the given
@@ -253,14 +302,28 @@ public:
 	//! Overloads the assignment operator.
 	/*!
       The overloaded operator does a deep copy of the object.
+	  If the left hand side is a view, both code words have to
+	  have the same length.
 	  \param oCodeWord The right hand side of the assignment.
 	  \return The left hand side of the assignment.
 	*/
 	CodeWord & operator=(const CodeWord & oCodeWord);
 
+	//! Overloads the move assignment operator.
+	/*!
+      The data of oCodeWord is taken if both code words own their
+	  data, oCodeWord is empty afterwards. Otherwise the data is copied
+	  as by the copy assignment, which allocates memory if the left hand
+	  side owns its data.
+	  \param oCodeWord The right hand side of the assignment.
+	  \return The left hand side of the assignment.
+	*/
+	CodeWord & operator=(CodeWord && oCodeWord);
+
 	//! Overloads the XOR operator.
 	/*!
       The overloaded operator xors each elements of the code words.
+	  The Hamming weight is updated in the same pass (see RowXorWeight).
 	  \param oCodeWord The right hand side of the assignment.
 	  \return The left hand side of the assignment.
 	*/
@@ -286,9 +349,41 @@ public:
 	const bool operator==(const CodeWord & oCodeWord) const;
 
 private:
+	friend class CodeMatrix;
+	friend class BlockElimination;
+
+	//! Turns the code word into a view of external data.
+	/*!
+	  \param pData Pointer to the first word.
+	  \param dLength The length of the code word in bits.
+	  \param dHammingWeight The Hamming weight of the data.
+	*/
+	void Bind(uint64_t * pData, uint64_t dLength, uint64_t dHammingWeight);
+
+	//! Changes the data pointer of a view.
+	/*!
+	  \param pData Pointer to the first word.
+	*/
+	void Rebind(uint64_t * pData);
+
+	//! Appends a 64-bit word to the data.
+	/*!
+	  \param dData The new word.
+	*/
+	void GrowWord(uint64_t dData);
+
+	//! Removes the last 64-bit word of the data.
+	void ShrinkWord();
+
+	//! Updates the data pointer after m_oData changed.
+	void Sync();
+
 	uint64_t              m_dHammingWeight;   //!< The Hamming weight of the code word.
-	std::vector<uint64_t> m_oData;            //!< The data.
-	uint8_t               m_dOffSet;          //!< Amount of free bits of the last word in m_oData.
+	std::vector<uint64_t> m_oData;            //!< The data if the code word is not a view.
+	uint64_t *            m_pData;            //!< Pointer to the data.
+	uint64_t              m_dLength64;        //!< Number of 64-bit words.
+	uint8_t               m_dOffSet;          //!< Amount of free bits of the last word in m_pData.
+	bool                  m_bView;            //!< True if the data is owned by a CodeMatrix.
 };
 
 #endif
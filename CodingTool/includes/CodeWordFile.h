@@ -29,6 +29,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <chrono>
 #include <cassert>
 
 #include "types.h"
@@ -59,7 +60,18 @@
   If the class is used to read a file then the parameters and code words are read from file.
   If the class is used to write to a file then first the parameters are written.
   Afterwards CodeWordFile::WriteCodeWord has to be used to write a code word directly into the file
-  after the header.
+  after the header.\n\n
+  The file stays open while code words are written. The records are
+  collected in a buffer, which is written if it is full, if the flush
+  interval has elapsed (see CodeWordFile::FlushIfDue), on CodeWordFile::Flush
+  and when the file is closed.\n\n
+  If binary records are enabled (see CodeWordFile::SetBinary), the line
+  \%BINARY follows the header and each record consists of the Hamming weight,
+  the length in bits and the code word as 64-bit words (first bit is the most
+  significant bit of the first word), all written as 64-bit numbers in the
+  byte order of the machine.\n\n
+  Large files can be read record by record with CodeWordFile::Open and
+  CodeWordFile::Next without building the CodeWordList.
 
   \see Parameters
   \see LowWeightSearch
@@ -86,7 +98,7 @@ public:
 
 	//! Destructor.
 	/*!
-	  Does nothing special.
+	  Writes the buffered records.
 	*/
 	virtual ~CodeWordFile(void);
 
@@ -114,12 +126,57 @@ public:
 	  CodeWord::SetFileName.
 	  The Hamming weight is written first. The code word is written
 	  bit-wise, where bits are separated by a whitespace.
+	  The record is buffered, see CodeWordFile::FlushIfDue.
 	  \param oCodeWord the code word.
 	  \return True if data was successfully written.
     */
-	// files are written directly to the file
 	bool WriteCodeWord(const CodeWord & oCodeWord);
 
+	//! Writes the buffered records to the file.
+	/*!
+	  \return True if data was successfully written.
+	*/
+	bool Flush();
+
+	//! Writes the buffered records if the flush interval has elapsed.
+	/*!
+	  This method is cheap if nothing has to be written and can be
+	  called frequently.
+	  \return True if data was successfully written.
+	*/
+	bool FlushIfDue();
+
+	//! Writes the buffered records and closes the file.
+	void Close();
+
+	//! Sets the time after which buffered records are written.
+	/*!
+	  \param dSeconds The interval in seconds, 0 writes every record immediately.
+	*/
+	void SetFlushInterval(uint64_t dSeconds);
+
+	//! Enables binary records.
+	/*!
+	  Has to be called before CodeWordFile::Write.
+	  \param bBinary True for binary records, false for text records.
+	*/
+	void SetBinary(bool bBinary);
+
+	//! Opens a code word file for reading record by record.
+	/*!
+	  Reads the header, the code words are returned by CodeWordFile::Next.
+	  \param sFileName The filename.
+	  \return True if the header was successfully read.
+	*/
+	bool Open(const std::string & sFileName);
+
+	//! Reads the next code word of a file opened by CodeWordFile::Open.
+	/*!
+	  \param oCodeWord The code word, its previous data is discarded.
+	  \return True if a code word was read, false at the end of the file.
+	*/
+	bool Next(CodeWord & oCodeWord);
+
 	//! Adds text to the beginning of the file.
 	/*!
       Adds the provided text at the beginning of the header.
@@ -167,25 +224,41 @@ private:
       \param oFileStream The file stream object.
 	  \return True if the file was successfully read.
     */
-	bool ReadHeader(std::fstream & oFileStream);
-
-	//! Reads the code words from the file.
-    /*! 
-	  The code words are stored in a CodeWordList.
-      \param oFileStream The file stream object.
-    */
-	void ReadCodeWords(std::fstream & oFileStream);
+	bool ReadHeader(std::istream & oFileStream);
 
 	//! Writes the header to the file.
     /*! 
       \param oFileStream The file stream object.
     */
-	void WriteHeader(std::fstream & oFileStream);
+	void WriteHeader(std::ostream & oFileStream);
+
+	//! Appends a text record to the buffer.
+	void FormatText(const CodeWord & oCodeWord);
+
+	//! Appends a binary record to the buffer.
+	void FormatBinary(const CodeWord & oCodeWord);
+
+	//! Parses a text record.
+	bool ParseText(const std::string & sLine, CodeWord & oCodeWord);
+
+	//! Reads a binary record.
+	bool ReadBinary(CodeWord & oCodeWord);
+
+	typedef std::chrono::steady_clock Clock; //!< Clock for the flush interval.
+
+	static const uint64_t BUFFERSIZE = 1 << 16; //!< Buffered bytes which force a write.
 
-	Parameters   m_oParameters;    //!< The parameters.
-	CodeWordList m_oCodeWordList;  //!< The list of code words.
-	std::string  m_sFileName;      //!< The filename.
-	std::string  m_sText;          //!< some text at the beginning of the header.
+	Parameters        m_oParameters;    //!< The parameters.
+	CodeWordList      m_oCodeWordList;  //!< The list of code words.
+	std::string       m_sFileName;      //!< The filename.
+	std::string       m_sText;          //!< some text at the beginning of the header.
+	std::ofstream     m_oOutput;        //!< The open output file.
+	std::ifstream     m_oInput;         //!< The open input file.
+	std::string       m_sBuffer;        //!< Records which are not yet written.
+	Clock::time_point m_oLastFlush;     //!< Time of the last write.
+	uint64_t          m_dFlushInterval; //!< Flush interval in seconds.
+	bool              m_bBinary;        //!< True if records are written in binary.
+	bool              m_bBinaryInput;   //!< True if the input file has binary records.
 
 };
 
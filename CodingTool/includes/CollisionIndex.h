@@ -0,0 +1,145 @@
+/*!
+  \file CollisionIndex.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class CollisionIndex.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef COLLISIONINDEX_H_
+#define COLLISIONINDEX_H_
+
+#include <vector>
+#include <cstddef>
+
+#include "types.h"
+
+//! The hash table used to find collisions in LowWeightSearch::CanteautChabaud.
+/*!
+  The index maps a key (the projection of a linear combination of rows
+  onto the sigma selected columns) to the row combinations with this key.
+  It is an open addressing hash table with linear probing. All entries
+  are stored in one array, entries with the same key are linked by their
+  array index. Each slot carries an epoch tag and is only valid if the tag
+  equals the current epoch. Therefore, no memory is allocated while the
+  table is filled (after the first iterations) and CollisionIndex::Clear
+  does not touch the table at all.
+
+  \see LowWeightSearch
+*/
+class CollisionIndex {
+public:
+	//! A row combination stored in the index.
+	struct Entry {
+		uint32_t dCombination;  //!< Index of the combination in the CombinationList of the engine.
+		uint32_t dRows;         //!< Number of rows used for the entry.
+		uint32_t dNext;         //!< Index of the next entry with the same key.
+	};
+
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	CollisionIndex(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~CollisionIndex(void);
+
+	//! Prepares the index for the given number of entries.
+	/*!
+	  The table gets at least twice as many slots as entries.
+	  The index grows by itself if more entries are inserted,
+	  but this involves a rehash of the table.
+	  \param dEntries Number of entries.
+	*/
+	void Reserve(uint64_t dEntries);
+
+	//! Adds a row combination.
+	/*!
+	  \param dKey The key of the combination.
+	  \param dCombination Index of the combination in the CombinationList of the engine.
+	  \param dRows Number of rows used.
+	*/
+	void Insert(uint64_t dKey, uint32_t dCombination, uint32_t dRows);
+
+	//! Returns the last added entry with the given key.
+	/*!
+	  Further entries with the same key are obtained by
+	  CollisionIndex::Next.
+	  \param dKey The key.
+	  \return Pointer to the entry or NULL if the key is not in the index.
+	*/
+	const Entry * Find(uint64_t dKey) const;
+
+	//! Returns the next entry with the same key.
+	/*!
+	  \param pEntry An entry of the index.
+	  \return Pointer to the entry or NULL if there is none.
+	*/
+	const Entry * Next(const Entry * pEntry) const;
+
+	//! Removes all entries.
+	/*!
+	  The memory is kept.
+	*/
+	void Clear();
+
+	//! Returns the number of entries.
+	uint64_t GetEntries() const;
+
+	//! Returns the allocated memory in bytes.
+	uint64_t GetMemory() const;
+
+	static const uint32_t NONE = 0xFFFFFFFF; //!< Marks the end of a list of entries.
+
+private:
+	//! A slot of the hash table.
+	struct Slot {
+		uint64_t dKey;    //!< The key.
+		uint32_t dEpoch;  //!< The slot is valid if it equals m_dEpoch.
+		uint32_t dHead;   //!< Index of the last added entry with this key.
+	};
+
+	//! Returns the first slot to probe for a key.
+	/*!
+	  \param dKey The key.
+	  \return Index of the slot.
+	*/
+	uint64_t Hash(uint64_t dKey) const;
+
+	//! Doubles the number of slots.
+	void Grow();
+
+	//! Rebuilds the table with a new number of slots.
+	/*!
+	  The entries are kept.
+	  \param dMinSlots Minimal number of slots, rounded up to a power of two.
+	*/
+	void Resize(uint64_t dMinSlots);
+
+	std::vector<Slot>  m_vSlots;    //!< The hash table.
+	std::vector<Entry> m_vEntries;  //!< All entries.
+	uint64_t           m_dMask;     //!< Number of slots minus one.
+	uint32_t           m_dShift;    //!< Shift used by CollisionIndex::Hash.
+	uint32_t           m_dEpoch;    //!< The current epoch.
+};
+
+#endif
@@ -0,0 +1,103 @@
+/*!
+  \file ColumnGather.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class ColumnGather.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef COLUMNGATHER_H_
+#define COLUMNGATHER_H_
+
+#include <vector>
+
+#include "types.h"
+
+//! This class extracts a fixed set of columns from rows of 64-bit words.
+/*!
+  The column indices are translated once into a list of runs. A run
+  consists of ascending columns which lie in the same 64-bit word of the
+  source row, together with the mask of these columns and the position
+  of the extracted bits in the destination row. The bits of a run are
+  extracted with one BMI2 PEXT instruction if the CPU supports it.
+  Hence, sorted column indices give the fewest runs.\n\n
+  The class is used by CodeMatrix::GetSubMatrix.
+
+  \see CodeMatrix
+*/
+class ColumnGather {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	ColumnGather(void);
+
+	//! Constructor.
+	/*!
+	  \param vCols The indices of the columns to extract.
+	*/
+	ColumnGather(const std::vector<uint64_t> & vCols);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~ColumnGather(void);
+
+	//! Sets the columns to extract.
+	/*!
+	  The order of the columns is kept in the destination row.
+	  \param vCols The indices of the columns.
+	*/
+	void SetColumns(const std::vector<uint64_t> & vCols);
+
+	//! Extracts the columns from one row.
+	/*!
+	  \param pSrc Pointer to the source row.
+	  \param pDst Pointer to the destination row. It must have
+	              ColumnGather::GetWords words, which are overwritten.
+	  \return The Hamming weight of the destination row.
+	*/
+	uint64_t Gather(const uint64_t * pSrc, uint64_t * pDst) const;
+
+	//! Returns the number of extracted columns.
+	uint64_t GetColumns() const;
+
+	//! Returns the number of 64-bit words of a destination row.
+	uint64_t GetWords() const;
+
+	//! Returns the number of runs.
+	uint64_t GetRuns() const;
+
+private:
+	//! A group of columns extracted at once.
+	struct Run {
+		uint64_t dMask;     //!< Mask of the columns in the source word.
+		uint32_t dSrcWord;  //!< Index of the source word.
+		uint32_t dDstWord;  //!< Index of the destination word.
+		uint32_t dDstEnd;   //!< Bit position after the run in the destination word.
+	};
+
+	std::vector<Run> m_vRuns;    //!< The runs.
+	uint64_t         m_dColumns; //!< Number of extracted columns.
+	uint64_t         m_dWords;   //!< Number of 64-bit words of a destination row.
+	bool             m_bPext;    //!< True if PEXT is used.
+};
+
+#endif
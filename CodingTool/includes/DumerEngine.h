@@ -0,0 +1,73 @@
+/*!
+  \file DumerEngine.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class DumerEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef DUMERENGINE_H_
+#define DUMERENGINE_H_
+
+#include "types.h"
+#include "IsdEngine.h"
+
+//! The collision search of Dumer's birthday decoding.
+/*!
+  The rows are not split. All combinations of up to p rows
+  (Parameters::P) of Z are projected onto a random window of sigma
+  columns and any two combinations with the same projection give a
+  candidate, rows which occur in both cancel out. Compared to
+  SternEngine each iteration covers more combinations, but the list
+  grows with the binomial coefficient of all rows.
+
+  \see IsdEngine
+*/
+class DumerEngine : public IsdEngine {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	DumerEngine(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~DumerEngine(void);
+
+	//! Returns a new engine with the same parameters.
+	virtual IsdEngine * Clone() const;
+
+	//! Returns the name of the engine.
+	virtual const char * GetName() const;
+
+	//! Runs one iteration.
+	/*!
+	  \param oZ The Z part of the systematic generator matrix.
+	  \param oRnGen The random number generator of the chain.
+	  \param oCallback Receives the candidates.
+	*/
+	virtual void Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback);
+
+private:
+	IsdEngine::CombinationList m_oList;  //!< The combinations of all rows.
+};
+
+#endif
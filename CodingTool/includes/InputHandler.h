@@ -50,6 +50,19 @@
 	- Parameters::PERMUTE permute the columns of a generator matrix
 	- Parameters::CWFILE code word file for the input
 	- Parameters::CMFILE file containing a code matrix
+	- Parameters::THREADS number of parallel search chains
+	- Parameters::BINARYCW write binary records to the code word file
+	- Parameters::ALGORITHM information set decoding algorithm
+	- Parameters::P number of rows per combination
+	- Parameters::CHECKPOINT checkpoint file of the search
+	- Parameters::CHECKPOINTTIME seconds between two checkpoints
+	- Parameters::RESUME checkpoint file to resume from
+	- Parameters::STATISTICS statistics file of the search (JSON or CSV)
+	- Parameters::STATISTICSTIME seconds between two lines of the statistics file
+	- Parameters::SEED seed of the random number generators
+	- Parameters::CHECKMATRIX the code matrix is a parity-check matrix
+	- Parameters::BOARD shared memory board of a multi-process search
+	- Parameters::PIN pin the search chains to cores
 
   \see Parameters
   
@@ -0,0 +1,264 @@
+/*!
+  \file IsdEngine.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the classes IsdEngine and IsdCallback.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ISDENGINE_H_
+#define ISDENGINE_H_
+
+#include <vector>
+#include <string>
+
+#include "types.h"
+#include "CodeMatrix.h"
+#include "ColumnGather.h"
+#include "CollisionIndex.h"
+#include "RandomNumberGenerator.h"
+#include "Parameters.h"
+#include "SearchStatistics.h"
+
+//! Receives the candidates found by an IsdEngine.
+/*!
+  The search driver (LowWeightSearch::Search) implements this interface
+  for each search chain. It computes the weight of the candidates and
+  keeps the code word with minimum weight.
+
+  \see IsdEngine
+*/
+class IsdCallback {
+public:
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~IsdCallback(void);
+
+	//! Returns true if the search should stop.
+	virtual bool IsStopped() = 0;
+
+	//! Handles a candidate.
+	/*!
+	  The candidate is the sum of the given rows of the systematic
+	  generator matrix.
+	  \param pRows The indices of the rows, all different.
+	  \param dRows Number of rows, at most MAXXORROWS.
+	*/
+	virtual void Candidate(const uint64_t * pRows, uint32_t dRows) = 0;
+};
+
+//! The interface of the information set decoding algorithms.
+/*!
+  An engine implements one iteration of an information set decoding
+  algorithm. The search driver LowWeightSearch::Search keeps the
+  generator matrix in systematic form (I|Z), applies Delta Gauss after
+  each iteration, runs several chains in parallel and checks the
+  candidates. In each iteration the engine searches sums of rows of the
+  generator matrix which are zero on a random window of sigma columns
+  of Z and passes them to the IsdCallback.\n\n
+  The base class provides the shared parts: the projections of the rows
+  onto the window, lists of row combinations and the CollisionIndex.
+  Each search chain uses its own engine (see IsdEngine::Clone).\n\n
+  The engines are:
+  - CanteautChabaudEngine ("cc"), combinations of up to p rows from each half
+  - SternEngine ("stern"), combinations of p rows from each half
+  - DumerEngine ("dumer"), collisions within one list of combinations of all rows
+  - MMTEngine ("mmt"), two-level merge of representations (May, Meurer, Thomae)
+
+  \see LowWeightSearch
+*/
+class IsdEngine {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	IsdEngine(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~IsdEngine(void);
+
+	//! Creates an engine.
+	/*!
+	  \param sName The name of the engine ("cc", "stern", "dumer" or "mmt").
+	  \return The new engine or NULL if the name is unknown.
+	*/
+	static IsdEngine * Create(const std::string & sName);
+
+	//! Returns a new engine with the same parameters.
+	virtual IsdEngine * Clone() const = 0;
+
+	//! Returns the name of the engine.
+	virtual const char * GetName() const = 0;
+
+	//! Reads the parameters of the engine.
+	/*!
+	  The base class reads Parameters::SIGMA and Parameters::P.
+	  \param oParameters The parameters.
+	  \return False if a value is not supported, an error is printed.
+	*/
+	virtual bool SetParameters(Parameters & oParameters);
+
+	//! Runs one iteration.
+	/*!
+	  \param oZ The Z part of the systematic generator matrix.
+	  \param oRnGen The random number generator of the chain.
+	  \param oCallback Receives the candidates.
+	*/
+	virtual void Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback) = 0;
+
+	//! Returns the statistics of the engine.
+	/*!
+	  The engine counts the combinations and collisions and times the
+	  projection, enumeration and collision phases. The caller collects
+	  and clears them.
+	*/
+	SearchStatistics & GetStatistics();
+
+	//! Limits the width of the window to the number of columns of Z.
+	/*!
+	  If sigma is larger than the number of columns of Z, all columns
+	  are used as window and an info is printed.
+	  \param dColumns Number of columns of Z, at least 1.
+	*/
+	void LimitSigma(uint64_t dColumns);
+
+	static const uint32_t MAXP     = 4;      //!< Largest supported number of rows per combination.
+	static const uint64_t MAXSIGMA = 64;     //!< Largest supported width of the window.
+	static const uint64_t MAXROWS  = 65536;  //!< Largest supported number of rows of Z.
+
+protected:
+	//! A list of row combinations.
+	/*!
+	  Combination i consists of the rows vRows[i*MAXP],...,vRows[i*MAXP+vCount[i]-1]
+	  and its key is the sum of the projections of the rows. The row indices
+	  are stored as compact 16-bit tuples, a combination needs 8 bytes.
+	*/
+	struct CombinationList {
+		std::vector<uint16_t> vRows;   //!< The row indices.
+		std::vector<uint8_t>  vCount;  //!< Number of rows of each combination.
+		std::vector<uint64_t> vKeys;   //!< The keys.
+
+		//! Removes all combinations, the memory is kept.
+		void Clear();
+
+		//! Returns the number of combinations.
+		uint64_t Size() const;
+
+		//! Adds a combination.
+		void Add(const uint16_t * pRows, uint32_t dCount, uint64_t dKey);
+
+		//! Returns the rows of a combination.
+		const uint16_t * Rows(uint64_t dIndex) const;
+	};
+
+	//! Projects all rows of Z onto random columns.
+	/*!
+	  The projection of row i is stored in m_vProj[i], the first of
+	  the selected columns is the most significant bit.
+	  \param oZ The Z part of the systematic generator matrix.
+	  \param dColumns Number of columns, at most 64.
+	  \param oRnGen The random number generator.
+	*/
+	void Project(const CodeMatrix & oZ, uint64_t dColumns, RandomNumberGenerator & oRnGen);
+
+	//! Lists the combinations of rows from a range.
+	/*!
+	  The combinations of each size are listed in revolving door order
+	  (a Gray code for combinations, see Knuth, TAOCP 7.2.1.3, Algorithm R).
+	  Two consecutive combinations differ in one row which is replaced by
+	  another, thus each key is computed from the previous one with a
+	  single XOR of two projections.
+	  \param dFirst The first row.
+	  \param dLast The row after the last row.
+	  \param dMinRows Minimal number of rows of a combination.
+	  \param dMaxRows Maximal number of rows of a combination, at most MAXP.
+	  \param oList The list, the combinations are appended.
+	*/
+	void Enumerate(uint64_t dFirst, uint64_t dLast, uint32_t dMinRows, uint32_t dMaxRows,
+	               CombinationList & oList);
+
+	//! Computes the next combination in revolving door order.
+	/*!
+	  \param pComb The combination, pComb[1] < ... < pComb[dRows] and
+	               pComb[dRows+1] is the number of rows to choose from.
+	  \param dRows Number of rows of the combination.
+	  \param dOut Returns the row which was removed.
+	  \param dIn Returns the row which was added.
+	  \return False if pComb was the last combination.
+	*/
+	static bool NextCombination(uint32_t * pComb, uint32_t dRows, uint32_t & dOut, uint32_t & dIn);
+
+	//! Passes the sum of two combinations to the callback.
+	/*!
+	  Rows which occur in both combinations cancel out. Nothing is passed
+	  if the sum is empty.
+	  \param pRows1 The rows of the first combination.
+	  \param dRows1 Number of rows of the first combination.
+	  \param pRows2 The rows of the second combination.
+	  \param dRows2 Number of rows of the second combination.
+	  \param oCallback The callback.
+	*/
+	void Emit(const uint16_t * pRows1, uint32_t dRows1, const uint16_t * pRows2, uint32_t dRows2,
+	          IsdCallback & oCallback) const;
+
+	//! Finds the collisions between two lists.
+	/*!
+	  oList1 is stored in m_oIndex and for each combination of oList2 the
+	  combinations of oList1 with the same key are passed to Emit.
+	  \param oList1 The first list.
+	  \param oList2 The second list.
+	  \param oCallback The callback.
+	  \param bLastOnly If true, only the last combination of oList1 with
+	                   the same key is used. This bounds the number of
+	                   candidates if many combinations have the same key
+	                   (e.g. for sparse matrices).
+	*/
+	void Collide(const CombinationList & oList1, const CombinationList & oList2, IsdCallback & oCallback,
+	             bool bLastOnly = false);
+
+	//! Finds the collisions within one list.
+	/*!
+	  \param oList The list.
+	  \param oCallback The callback.
+	*/
+	void Collide(const CombinationList & oList, IsdCallback & oCallback);
+
+	//! Adds the time since dStart to the collision phase and records the memory of m_oIndex.
+	/*!
+	  \param dStart Start of the phase (SearchStatistics::Now).
+	*/
+	void UpdateIndexStatistics(uint64_t dStart);
+
+	std::vector<uint64_t> m_vProj;     //!< Projections of the rows of Z.
+	std::vector<uint64_t> m_vRows;     //!< The indices of all rows of Z.
+	std::vector<uint64_t> m_vCols;     //!< The columns of the window.
+	ColumnGather          m_oGather;   //!< Extracts the window.
+	CodeMatrix            m_oWindow;   //!< The rows of Z restricted to the window.
+	CollisionIndex        m_oIndex;    //!< The hash table of the collisions.
+	uint64_t              m_dSigma;    //!< Width of the window (Parameters::SIGMA).
+	uint32_t              m_dP;        //!< Number of rows per combination (Parameters::P).
+	SearchStatistics      m_oStatistics; //!< Counters and timers of the engine.
+};
+
+#endif
@@ -32,13 +32,23 @@
 #include <fstream>
 #include <cstring>
 #include <cmath>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 #include "types.h"
 #include "RandomNumberGenerator.h"
 #include "CodeWord.h"
 #include "CodeMatrix.h"
 #include "CodeWordFile.h"
+#include "BlockElimination.h"
+#include "IsdEngine.h"
+#include "CanteautChabaudEngine.h"
 #include "Parameters.h"
+#include "SearchStatistics.h"
+#include "SharedBoard.h"
 
 
 //! The main part of the CodingTool library.
@@ -52,6 +62,8 @@
   implements an algorithm for finding low Hamming word code words.
   The user has only to provide a generator matrix (CodeMatrix). The
   algorithm returns a code word with the lowest Hamming weight found.
+  Other information set decoding algorithms (see IsdEngine) are run by
+  LowWeightSearch::Search.
   \n\n
   Other functionalities are:
 
@@ -63,6 +75,9 @@
   - LowWeightSearch::SetCheckFunction : sets a user defined function which checks the validity of a code
                        word during the search.
 
+  - LowWeightSearch::SearchCheck : searches code words with low Hamming weight directly
+                       on a parity-check matrix.
+
   - LowWeightSearch::CheckToGenerator : transforms a check matrix to a generator matrix.
 
   - LowWeightSearch::SetWeightVector : sets weights for specific bits of the code, if not each bit
@@ -105,9 +120,41 @@ public:
 	  if different bits of the code word should be weighted differently.\n\n
 	  If Parameters::PERMUTE is set the columns of the generator matrix
 	  are permuted using LowWeightSearch::RandomPermuteColumns.\n\n
+	  If Parameters::THREADS is larger than one, several independent search
+	  chains are run in parallel. Each chain has its own copy of the systematic
+	  generator matrix, its own random number generator and its own hash table.
+	  The chains share the minimum weight found so far and the number of
+	  iterations, i.e. Parameters::ITER is the total number of iterations of all
+	  chains. All chains write to the same code word file. In that case the
+	  check function has to be thread-safe.
+	  \n\n
+	  The collision search of an iteration is done by CanteautChabaudEngine,
+	  see LowWeightSearch::Search for other algorithms.
+	  \n\n
+	  If Parameters::CHECKPOINT is set, the state of the search is saved
+	  to that file every Parameters::CHECKPOINTTIME seconds and at the end
+	  of the search. The state contains the matrices and permutations of
+	  all chains, their random number generators and the minimum found so
+	  far. The file is replaced atomically, an interrupted write leaves the
+	  previous checkpoint intact. With Parameters::RESUME the search
+	  continues from a checkpoint instead of starting with a new systematic
+	  generator matrix. The generator matrix has to be the same, the number
+	  of chains is taken from the checkpoint (a warning is printed if
+	  Parameters::THREADS differs) and Parameters::ITER stays the total
+	  number of iterations, including the ones before the checkpoint.
+	  \n\n
+	  The random number generators of the chains are derived from
+	  Parameters::SEED, chain i uses the stream after i+1 jumps (see
+	  RandomNumberGenerator::jump). If the seed is zero, a random seed is
+	  drawn and printed. With one chain the search is reproducible, with
+	  several chains the iterations are distributed by the scheduler.
 	  \n\n
-	  This class offers a lot of possible improvements. Additional (faster) search algorithms or
-	  faster implementations can easily be added.
+	  The search counts iterations, collisions, candidates and the time
+	  of each phase (see SearchStatistics and LowWeightSearch::GetStatistics).
+	  If Parameters::STATISTICS is set, the statistics are appended to that
+	  file every Parameters::STATISTICSTIME seconds and at the end of the
+	  search, as CSV if the file name ends with ".csv", otherwise as one
+	  JSON object per line.
 
 
       \param oGenerator The generator matrix.
@@ -116,10 +163,68 @@ public:
 	*/
 	CodeWord CanteautChabaud(CodeMatrix oGenerator, Parameters  & oParameters);
 
+    //! Runs the information set decoding algorithm given by the parameters.
+	/*!
+	  The algorithm is selected by Parameters::ALGORITHM, see IsdEngine::Create.
+      \param oGenerator The generator matrix.
+	  \param oParameters The parameters for the search.
+	  \return The code word with the lowest Hamming weight found.
+	*/
+	CodeWord Search(CodeMatrix oGenerator, Parameters & oParameters);
+
+    //! Runs an information set decoding algorithm.
+	/*!
+	  The search is done as described for LowWeightSearch::CanteautChabaud,
+	  but the collision search of each iteration is done by the given
+	  engine. Each chain uses its own copy of the engine (IsdEngine::Clone).
+	  The engine reads its parameters from oParameters (IsdEngine::SetParameters).
+	  The search transforms its own copy of the generator matrix, a caller
+	  which does not need the matrix afterwards can pass it with std::move.
+      \param oGenerator The generator matrix.
+	  \param oParameters The parameters for the search.
+	  \param oEngine The engine.
+	  \return The code word with the lowest Hamming weight found.
+	*/
+	CodeWord Search(CodeMatrix oGenerator, Parameters & oParameters, IsdEngine & oEngine);
+
+    //! Searches code words with low Hamming weight of the code given by a check matrix.
+	/*!
+	  The algorithm is selected by Parameters::ALGORITHM, see IsdEngine::Create.
+	  \param oCheck The parity-check matrix H, its rows have to be linearly independent.
+	  \param oParameters The parameters for the search.
+	  \return The code word with the lowest Hamming weight found.
+	*/
+	CodeWord SearchCheck(CodeMatrix oCheck, Parameters & oParameters);
+
+    //! Runs an information set decoding algorithm on a check matrix.
+	/*!
+	  The r x n check matrix H is transformed to the systematic form (I|Q)
+	  by BlockElimination, no generator matrix is created. The code words
+	  are (Qx|x), hence the rows of Z are the columns of Q and the sum of
+	  some rows of Z is the syndrome of the information bits. The engine
+	  searches combinations whose syndromes collide on a window of sigma
+	  syndrome bits, the weight of a candidate is the number of combined
+	  columns plus the weight of the syndrome. Z = Q^T has only k x r
+	  bits, the search itself is the same as for a generator matrix (see
+	  LowWeightSearch::Search), including the parallel chains, the
+	  checkpoints and the weight vector. The code words are returned in
+	  the column order of H. The Gauss combinations (see
+	  LowWeightSearch::GetGaussCombinations) refer to the systematic
+	  generator matrix (I|Q^T) in that case.
+	  \param oCheck The parity-check matrix H, its rows have to be linearly independent.
+	  \param oParameters The parameters for the search.
+	  \param oEngine The engine.
+	  \return The code word with the lowest Hamming weight found.
+	*/
+	CodeWord SearchCheck(CodeMatrix oCheck, Parameters & oParameters, IsdEngine & oEngine);
+
     //! Transforms the matrix to reduced row echelon form.
 	/*!
       During the operations the columns maybe permuted.
 	  The method returns the permutation of the columns.
+	  The row operations are also applied to the Gauss combinations
+	  (see LowWeightSearch::GetGaussCombinations) if they are enabled
+	  and created. The elimination is done by BlockElimination.
 	  \param oMatrix The code matrix.
 	  \return The permutation of the columns.
 	*/
@@ -128,7 +233,8 @@ public:
     //! Randomly permutes the columns of the given matrix.
 	/*!
       This method can be used to increase the randomness of the
-	  search algorithm.
+	  search algorithm. The columns are moved with
+	  CodeMatrix::PermuteColumns.
 	  \param oMatrix The code matrix.
 	  \return The permutation of the columns.
 	*/
@@ -155,30 +261,99 @@ public:
     //! Returns the performed Gaussian combinations during the search.
 	/*!
       After each iteration Delta Gauss is applied on the generator matrix.
-	  In parallel the same operations are applied on an identity matrix.
-	  This matrix is returned by this method.
+	  The matrix returned by this method represents the same operations
+	  applied on an identity matrix. The Delta Gauss operations are not
+	  recorded during the search, they are reconstructed at the first
+	  call after a search (see LowWeightSearch::ApplyDeltaGauss).
+	  The combinations are only recorded if they are enabled by
+	  LowWeightSearch::SetGaussTracking, otherwise the matrix is empty.
 	  \return A reference to the matrix representing the performed Gaussian
 	          operations.
 	*/
 	CodeMatrix & GetGaussCombinations();
 
+    //! Returns the statistics of the last search.
+	/*!
+	  The counters and timers of all chains are added up.
+	  \return The statistics.
+	*/
+	const SearchStatistics & GetStatistics() const;
+
+    //! A generator matrix in systematic form, see LowWeightSearch::SetSystematicForm.
+	struct SystematicForm {
+		CodeMatrix            oGenerator;          //!< The systematic generator matrix.
+		std::vector<uint64_t> vGaussPerm;          //!< The permutation done by LowWeightSearch::GaussMod2.
+		CodeMatrix            oGaussCombinations;  //!< The Gauss combinations of LowWeightSearch::GaussMod2, empty if they are disabled.
+	};
+
+    //! Transforms a generator matrix into systematic form.
+	/*!
+      The result can be used by several searches on the same code
+	  (see LowWeightSearch::SetSystematicForm), such that the Gauss
+	  elimination is done only once. The Gauss combinations are only
+	  computed if they are enabled (see LowWeightSearch::SetGaussTracking).
+	  \param oGenerator The generator matrix.
+	  \param oForm Returns the systematic form.
+	*/
+	void ComputeSystematicForm(const CodeMatrix & oGenerator, SystematicForm & oForm);
+
+    //! Sets a precomputed systematic form for the following searches.
+	/*!
+      If the generator matrix of a search has the same size and
+	  Parameters::PERMUTE is not set, the search starts with the given
+	  systematic form instead of calling LowWeightSearch::GaussMod2.
+	  The object is not copied and has to exist during the searches,
+	  it is only read. NULL disables the systematic form.
+	  \param pForm The systematic form of the generator matrix or NULL.
+	*/
+	void SetSystematicForm(const SystematicForm * pForm);
+
+    //! Sets the board of a multi-process search.
+	/*!
+	  The search joins the board as a worker (see SharedBoard). After
+	  each iteration the progress is published and the global minimum
+	  of all processes is used as bound for the candidates. New minima
+	  are offered to the board instead of being written to the code
+	  word file, the coordinator writes them. The search stops if the
+	  board is stopped or the global minimum reaches Parameters::MINIMUM.
+	  The object is not copied and has to stay attached during the
+	  searches. NULL disables the board.
+	  \param pBoard The attached board or NULL.
+	*/
+	void SetBoard(SharedBoard * pBoard);
+
     //! Sets the weight vector.
 	/*!
       Sets the weight vector if bits of the code words
 	  should be weighted differently. The length of the vector
-	  has to be the same as the length of the code.
+	  has to be the same as the length of the code, vWeights[i] is the
+	  weight of column i. An empty vector disables the weighting.
 	  \param vWeights The weights.
 	*/
 	void SetWeightVector(std::vector<uint64_t> & vWeights);
 
+    //! Enables the Gauss combinations for the following searches.
+	/*!
+      The Gauss combinations are a dim x dim matrix, LowWeightSearch::GaussMod2
+	  applies each row operation to them as well. Hence they are only
+	  created if they are enabled, see LowWeightSearch::GetGaussCombinations.
+	  A precomputed systematic form (see LowWeightSearch::SetSystematicForm)
+	  is only used if it has the combinations. A checkpoint written without
+	  them is resumed with a warning, the combinations stay empty then.
+	  Disabled by default.
+	  \param bTrack True if the Gauss combinations are recorded.
+	*/
+	void SetGaussTracking(bool bTrack);
+
     //! Transforms a check matrix to a generator matrix.
 	/*!
       A cryptanalyst may face scenarios where she/he has rather
 	  a check matrix than a generator matrix. This method
-	  transforms the given check matrix to a generator matrix.
-	  May be not necessary in the future if search algorithms
-	  are implemented which work directly with check matrices.
-	  \param oCheckMatrix The check matrix.
+	  transforms the given check matrix to a generator matrix
+	  with the same column order. LowWeightSearch::SearchCheck
+	  searches directly on the check matrix.
+	  \param oCheckMatrix The check matrix, its rows have to be linearly independent.
+	  \return The generator matrix or an empty matrix if an error is printed.
 	*/
 	static CodeMatrix CheckToGenerator(CodeMatrix & oCheckMatrix);
 
@@ -191,7 +366,7 @@ public:
 	  matrix to zero by code shortening, where n is the output size of the hash function.
 	  In that way, the code words found by the search algorithm produce
 	  a collision for the linearized hash function.\n\n\n
-	  This method uses Gaussian elimination to fulfill its task. The code
+	  This method uses Gaussian elimination (BlockElimination) to fulfill its task. The code
 	  dimension and code length is reduced. If the dimension is reduced to
 	  zero, i.e. forcing to much columns to zero may not have a solution,
 	  an error is printed.
@@ -212,20 +387,102 @@ public:
 	void AddInformation(const std::string & sInfo);
 
 private:
-	//! An entry for the hash table used in LowWeightSearch::CanteautChabaud.
+	//! The state of a search chain which is stored in a checkpoint.
+	struct ChainSnapshot {
+		CodeMatrix            oZ;                  //!< The Z part of the systematic generator matrix.
+		std::vector<uint64_t> vColsPerm;           //!< The permutation done by LowWeightSearch::DeltaGauss.
+		uint64_t              aRnGen[RandomNumberGenerator::STATEWORDS]; //!< The state of the random number generator.
+		uint64_t              dDone;               //!< Number of finished iterations.
+	};
+
+	//! The state of one search chain of LowWeightSearch::CanteautChabaud.
 	/*!
-	   This struct is used fo build the hash table for the
-	   search algorithm.
+	   Each chain works on its own copy of the systematic generator
+	   matrix, therefore chains can run in parallel. The copy is made by
+	   the thread of the chain (see LowWeightSearch::InitChain), hence its
+	   pages are first touched and placed on the NUMA node of the chain.
 	*/
-	struct HashTableRecord {
-		uint64_t dRow1;  //!< Index of row one.
-		uint64_t dRow2;  //!< Index of row two.
-		uint32_t dRows;  //!< Number of rows used for the record.
-		struct HashTableRecord * pNextRecord; //!< Pointer to the next record.
+	struct SearchChain {
+		CodeMatrix            oZ;                  //!< The Z part of the systematic generator matrix.
+		const CodeMatrix *    pInitialZ;           //!< The matrix which is copied to oZ by LowWeightSearch::InitChain.
+		uint32_t              dCpu;                //!< The core of the chain or NOCPU if it is not pinned.
+		std::vector<uint64_t> vColsPerm;           //!< The permutation done by LowWeightSearch::DeltaGauss.
+		RandomNumberGenerator oRnGen;              //!< The random number generator of this chain.
+		IsdEngine *           pEngine;             //!< The collision search of this chain.
+		std::vector<uint64_t> vColumn;             //!< The pivot column of LowWeightSearch::DeltaGauss.
+		WeightTable           oWeights;            //!< The weights of the columns of Z, empty if not weighted.
+		std::vector<uint64_t> vRowWeights;         //!< The weights of the columns of the identity part.
+		uint64_t              dDone;               //!< Number of finished iterations of this chain.
+		uint64_t              dGeneration;         //!< The last checkpoint which contains this chain.
+		ChainSnapshot         oSaved;              //!< The state of the chain for the checkpoint.
+		SearchStatistics      oStatistics;         //!< Counters of this chain since the last iteration.
+
+		static const uint32_t NOCPU = 0xFFFFFFFF;  //!< Value of dCpu for a chain which is not pinned.
+	};
+
+	//! The state shared by all chains of LowWeightSearch::CanteautChabaud.
+	struct SearchState {
+		uint64_t              dMaxIterations; //!< Value of Parameters::ITER.
+		uint64_t              dMinimum;       //!< Value of Parameters::MINIMUM.
+		bool                  bOutput;        //!< False if Parameters::DOUTPUT is set.
+		bool                  bPin;           //!< Value of Parameters::PIN.
+		std::vector<uint64_t> vGaussPerm;     //!< The permutation done by LowWeightSearch::GaussMod2.
+		std::vector<uint64_t> vRandPerm;      //!< The permutation done by LowWeightSearch::RandomPermuteColumns.
+		std::vector<uint64_t> vFinalPerm;     //!< vGaussPerm and vRandPerm composed, see LowWeightSearch::ComposePermutations.
+
+		std::atomic<uint64_t> dMinWeight;     //!< The minimum weight found by all chains.
+		std::atomic<uint64_t> dIterations;    //!< Number of started iterations of all chains.
+		std::atomic<bool>     bStop;          //!< True if all chains should stop.
+		std::mutex            oMutex;         //!< Protects the members below and the output.
+		CodeWord              oMinimum;       //!< The code word with minimum weight.
+		uint64_t              dMinimumWeight; //!< The weight of oMinimum, dMinWeight may be lower with a board.
+		SearchChain *         pMinimumChain;  //!< The chain which found oMinimum.
+
+		std::string           sCheckpoint;    //!< Value of Parameters::CHECKPOINT.
+		uint64_t              dCheckpointTime; //!< Value of Parameters::CHECKPOINTTIME.
+		std::chrono::steady_clock::time_point tCheckpoint; //!< Time of the next checkpoint.
+		uint64_t              dGeneration;    //!< Number of started checkpoints.
+		uint64_t              dSaved;         //!< Number of chains which saved their state for the current checkpoint.
+		bool                  bPending;       //!< True if a checkpoint is started but not written.
+		CodeWord              oSavedMinimum;  //!< oMinimum when the last chain saved its state.
+		std::vector<uint64_t> vSavedRows;     //!< LowWeightSearch::m_vCombinedRows at that time.
+		uint64_t              dSavedWeight;   //!< dMinimumWeight at that time.
+		uint64_t              dSavedChain;    //!< Index of pMinimumChain at that time, the number of chains if none.
+		std::vector<SearchChain*> vChains;    //!< All chains.
+
+		SearchStatistics      oStatistics;    //!< The statistics of all chains.
+		uint64_t              dStart;         //!< Start of the search (SearchStatistics::Now).
+		std::ofstream         oStatisticsFile; //!< The file of Parameters::STATISTICS.
+		bool                  bCsv;           //!< True if the statistics are written as CSV.
+		uint64_t              dStatisticsTime; //!< Value of Parameters::STATISTICSTIME.
+		std::chrono::steady_clock::time_point tStatistics; //!< Time of the next statistics line.
 	};
 
-	//! Type definition for a hash table entry.
-	typedef struct HashTableRecord HashTableRecord;
+	//! Passes the candidates of the engine of a chain to LowWeightSearch::UpdateMinimum.
+	class ChainCallback : public IsdCallback {
+	public:
+		//! Constructor.
+		/*!
+		  \param oSearch The search.
+		  \param oChain The search chain.
+		  \param oState The state shared by all chains.
+		*/
+		ChainCallback(LowWeightSearch & oSearch, SearchChain & oChain, SearchState & oState);
+
+		//! Returns true if the search should stop.
+		virtual bool IsStopped();
+
+		//! Checks the weight of a candidate and stores it if it is a new minimum.
+		virtual void Candidate(const uint64_t * pRows, uint32_t dRows);
+
+		bool                  m_bMinWeightChanged; //!< True if the chain found a new minimum.
+
+	private:
+		LowWeightSearch &     m_oSearch;           //!< The search.
+		SearchChain &         m_oChain;            //!< The search chain.
+		SearchState &         m_oState;            //!< The state shared by all chains.
+		std::vector<uint64_t> m_vMinimum;          //!< The rows of a new minimum.
+	};
 	
 
     //! Builds the code word.
@@ -233,27 +490,248 @@ private:
       During the search algorithm the generator matrix changes.
 	  This method builds the code word which corresponds to the
 	  original matrix, i.e. linear combination of the specific rows
-	  is computed and all permutations are reversed.
+	  is computed and all permutations are reversed. The permutations
+	  are applied to the ones of the code word only.
 	  \param vMinimum The indices of the rows which will be combined.
 	  \param oZ The Z part of the generator matrix.
 	  \param vColsPerm The permutation done by LowWeightSearch::DeltaGauss.
+	  \param vFinalPerm The permutations before the search (see LowWeightSearch::ComposePermutations).
+	*/
+	CodeWord BuildMinVector(const std::vector<uint64_t> & vMinimum, CodeMatrix & oZ,
+							const std::vector<uint64_t> & vColsPerm,
+							const std::vector<uint64_t> & vFinalPerm);
+
+    //! Composes the permutations which are done before the search.
+	/*!
+      Column j of the systematic generator matrix is column
+	  vRandPerm[vGaussPerm[j]] of the original matrix. The permutations
+	  are composed once per search instead of being reversed one after
+	  the other for each code word. An empty permutation is the identity.
 	  \param vGaussPerm The permutation done by LowWeightSearch::GaussMod2.
 	  \param vRandPerm The permutation done by LowWeightSearch::RandomPermuteColumns.
+	  \param dColumns The length of the code.
+	  \return The composed permutation.
 	*/
-	CodeWord BuildMinVector(std::vector<uint64_t> & vMinimum, CodeMatrix & oZ,
-							std::vector<uint64_t> & vColsPerm,
-							std::vector<uint64_t> & vGaussPerm,
-							std::vector<uint64_t> & vRandPerm);
+	static std::vector<uint64_t> ComposePermutations(const std::vector<uint64_t> & vGaussPerm,
+	                                                 const std::vector<uint64_t> & vRandPerm, uint64_t dColumns);
 
     //! Performs Delta Gauss on a given matrix.
 	/*!
       After each iteration of LowWeightSearch::CanteautChabaud this method
 	  is called. It exchanges randomly two columns and applies Delta Gauss
-	  on the generator matrix.
-	  \param[in] oZ The Z part of the systematic generator matrix.
-	  \param[out] vColsPerm The permutation of the columns.
+	  on the generator matrix of the chain.
+	  \param oChain The search chain.
+	*/
+	void DeltaGauss(SearchChain & oChain);
+
+    //! Creates the engine given by Parameters::ALGORITHM.
+	/*!
+	  \param oParameters The parameters.
+	  \return The new engine or NULL if an error is printed.
+	*/
+	static IsdEngine * CreateEngine(Parameters & oParameters);
+
+    //! Runs the search of LowWeightSearch::Search or LowWeightSearch::SearchCheck.
+	/*!
+	  \param oMatrix The generator or check matrix.
+	  \param bCheckMatrix True if oMatrix is a check matrix.
+	  \param oParameters The parameters for the search.
+	  \param oEngine The engine.
+	  \return The code word with the lowest Hamming weight found.
+	*/
+	CodeWord RunSearch(CodeMatrix & oMatrix, bool bCheckMatrix, Parameters & oParameters, IsdEngine & oEngine);
+
+    //! Computes Z of a check matrix.
+	/*!
+	  The check matrix H is transformed to (I|Q), Z is Q^T. Column j of
+	  the systematic generator matrix (I|Z) is column vPerm[j] of H.
+	  \param oCheckMatrix The check matrix, it is not changed.
+	  \param oZ Returns Z.
+	  \param vPerm Returns the permutation of the columns.
+	  \return False if the rows of H are linearly dependent, an error is printed.
+	*/
+	static bool CheckSystematicForm(CodeMatrix & oCheckMatrix, CodeMatrix & oZ, std::vector<uint64_t> & vPerm);
+
+    //! Runs the iterations of one search chain.
+	/*!
+      This method runs iterations of LowWeightSearch::CanteautChabaud on the
+	  given chain until the total number of iterations is reached or
+	  the search is stopped. The shared state is only updated every
+	  SYNCINTERVAL milliseconds or if the chain found a new minimum.
+	  \param oChain The search chain.
+	  \param oState The state shared by all chains.
+	*/
+	void RunChain(SearchChain & oChain, SearchState & oState);
+
+	static const uint64_t SYNCINTERVAL = 100; //!< Milliseconds between two updates of the shared state by a chain.
+
+    //! Prepares a chain in its own thread.
+	/*!
+      The thread is pinned to SearchChain::dCpu, then Z is copied from
+	  SearchChain::pInitialZ and the weights are set. Linux places a page
+	  on the NUMA node of the thread which touches it first, hence Z, the
+	  weights and the scratch space of the engine, which are allocated
+	  during the first iteration, are local to the core of the chain.
+	  \param oChain The search chain.
+	  \param oState The state shared by all chains.
+	*/
+	void InitChain(SearchChain & oChain, SearchState & oState);
+
+    //! Returns the cores for pinning the search chains.
+	/*!
+      Only the cores of the affinity mask of the process are used. They
+	  are ordered round-robin over the NUMA nodes, thus consecutive
+	  chains are spread over all nodes and use the memory bandwidth of
+	  all sockets.
+	  \return The cores, empty if they are unknown.
+	*/
+	static std::vector<uint32_t> GetCpus();
+
+    //! Pins the calling thread to a core.
+	/*!
+	  \param dCpu The core.
+	  \return False if the thread could not be pinned.
+	*/
+	static bool PinThread(uint32_t dCpu);
+
+    //! Returns the weight of a collision candidate.
+	/*!
+      The candidate is the sum of some rows of the systematic generator
+	  matrix, i.e. the sum of the rows of Z plus one bit per row in the
+	  identity part. If m_vWeights is set, the bits are weighted with the
+	  weights of the columns they are permuted from (see
+	  LowWeightSearch::InitWeights). The rows are processed in chunks and
+	  the computation stops as soon as the weight reaches dMinWeight.
+	  \param oChain The chain of the candidate.
+	  \param pRows The indices of the rows.
+	  \param dRows Number of rows.
+	  \param dMinWeight The current minimum.
+	  \return The weight of the candidate if it is lower than dMinWeight,
+	          otherwise a value which is at least dMinWeight.
+	*/
+	uint64_t CandidateWeight(const SearchChain & oChain, const uint64_t * pRows, uint32_t dRows,
+	                         uint64_t dMinWeight) const;
+
+    //! Sets the weights of the columns of a chain.
+	/*!
+      Column i of the permuted generator matrix is the column
+	  vFinalPerm[vColsPerm[i]] of the original code, hence it has the
+	  weight m_vWeights[vFinalPerm[vColsPerm[i]]]. LowWeightSearch::DeltaGauss
+	  swaps the weights of the pivot column with the columns.
+	  \param oChain The chain, oZ and vColsPerm have to be set.
+	  \param vFinalPerm The permutations before the search (see LowWeightSearch::ComposePermutations).
+	*/
+	void InitWeights(SearchChain & oChain, const std::vector<uint64_t> & vFinalPerm) const;
+
+    //! Handles a code word with lower weight than the current minimum.
+	/*!
+      The code word is built, checked with the check function and
+	  stored if its weight is still lower than the minimum of all chains.
+	  \param oChain The search chain which found the code word.
+	  \param oState The state shared by all chains.
+	  \param vMinimum The indices of the rows which will be combined.
+	  \param dWeight The weight of the code word.
+	  \return True if the code word is the new minimum.
+	*/
+	bool UpdateMinimum(SearchChain & oChain, SearchState & oState,
+	                   std::vector<uint64_t> & vMinimum, uint64_t dWeight);
+
+    //! Adds the statistics of a chain and its engine to the statistics of the search.
+	/*!
+      This method is called by each chain every SYNCINTERVAL milliseconds,
+	  if it found a new minimum and when it ends, with
+	  SearchState::oMutex locked. Meanwhile the statistics are kept in
+	  the chain and its engine. A line is written to the statistics
+	  file if Parameters::STATISTICSTIME has passed.
+	  \param oChain The search chain.
+	  \param oState The state shared by all chains.
+	*/
+	void CollectStatistics(SearchChain & oChain, SearchState & oState);
+
+    //! Exchanges the progress and the minimum weight with the board.
+	/*!
+      This method is called with the statistics (see
+	  LowWeightSearch::CollectStatistics) and SearchState::oMutex
+	  locked if a board is set (see LowWeightSearch::SetBoard).
+	  \param oState The state shared by all chains.
 	*/
-	void DeltaGauss(CodeMatrix & oZ, std::vector<uint64_t> & vColsPerm);
+	void SyncBoard(SearchState & oState);
+
+    //! Writes a new minimum to the code word file or offers it to the board.
+	/*!
+	  \param oCodeWord The code word.
+	  \param dWeight The weight of the code word.
+	*/
+	void PublishMinimum(const CodeWord & oCodeWord, uint64_t dWeight);
+
+    //! Writes the statistics of the search to the statistics file.
+	/*!
+	  \param oState The state shared by all chains.
+	*/
+	void WriteStatistics(SearchState & oState);
+
+    //! Saves the state of a chain for a checkpoint.
+	/*!
+      This method is called with the statistics (see
+	  LowWeightSearch::CollectStatistics) and SearchState::oMutex
+	  locked. If the checkpoint time has passed, a
+	  checkpoint is started. Each chain copies its state once into
+	  SearchChain::oSaved. The last chain also saves the minimum and
+	  writes the file after it released the mutex (see
+	  LowWeightSearch::FinishCheckpoint). Thus the chains never wait for
+	  each other or for the disk.
+	  \param oChain The search chain.
+	  \param oState The state shared by all chains.
+	  \return True if the chain has to call LowWeightSearch::FinishCheckpoint.
+	*/
+	bool Checkpoint(SearchChain & oChain, SearchState & oState);
+
+    //! Writes the checkpoint which was completed by LowWeightSearch::Checkpoint.
+	/*!
+      This method is called without SearchState::oMutex locked. The saved
+	  states are not changed by the other chains until the checkpoint is
+	  finished, because no new checkpoint starts before. The saved states
+	  are kept, thus later checkpoints reuse their memory.
+	  \param oState The state shared by all chains.
+	*/
+	void FinishCheckpoint(SearchState & oState);
+
+    //! Saves the minimum for the checkpoint.
+	/*!
+	  \param oState The state shared by all chains.
+	*/
+	void SaveMinimum(SearchState & oState);
+
+    //! Copies the state of a chain into SearchChain::oSaved.
+	/*!
+	  \param oChain The search chain.
+	*/
+	void SaveChain(SearchChain & oChain);
+
+    //! Writes a checkpoint file.
+	/*!
+      The state of the chains is taken from SearchChain::oSaved and the
+	  minimum from SearchState::oSavedMinimum. The file
+	  is written to a temporary file which replaces Parameters::CHECKPOINT
+	  after it was written completely.
+	  \param oState The state shared by all chains.
+	  \return True if the file was written.
+	*/
+	bool WriteCheckpoint(SearchState & oState);
+
+    //! Reads a checkpoint file.
+	/*!
+	  \param sFileName The checkpoint file.
+	  \param dRows The dimension of the code.
+	  \param dColumns The length of the code.
+	  \param oState Returns the permutations, the minimum and the number of iterations.
+	  \param vSnapshots Returns the state of the chains.
+	  \param dMinimumChain Returns the index of the chain which found the
+	                       minimum or the number of chains.
+	  \return True if the file was read.
+	*/
+	bool ReadCheckpoint(const std::string & sFileName, uint64_t dRows, uint64_t dColumns, SearchState & oState,
+	                    std::vector<ChainSnapshot> & vSnapshots, uint64_t & dMinimumChain);
 
     //! Checks the values of the parameters.
 	/*!
@@ -270,18 +748,30 @@ private:
 	*/
 	void CreateGaussMatrix(uint64_t dDim);
 
-    //! Deletes the hash table.
+    //! Adds the Delta Gauss operations of the last search to the Gauss combinations.
 	/*!
-      \param aHashTable Pointer to the table.
-	  \param dMaxTableSize Table size.
+	  The rows of the generator matrix after the search are sums of the
+	  rows of the systematic generator matrix before the search. The
+	  coefficients are the bits of the current rows at the original
+	  positions of the identity part, they are read from m_oDeltaZ and
+	  m_vDeltaPerm. The Gauss combinations are multiplied by them, the
+	  rows are added word by word (see CodeWord::operator^=).
 	*/
-	void FreeHashTable(HashTableRecord** aHashTable,uint64_t dMaxTableSize);
-
-	CodeMatrix            m_oGaussCombinations;  //!< Represents the performed Delta Gauss operations.
+	void ApplyDeltaGauss();
+
+	CodeMatrix            m_oGaussCombinations;  //!< Represents the performed Gauss operations.
+	CodeMatrix            m_oDeltaZ;             //!< Z after the last search.
+	std::vector<uint64_t> m_vDeltaPerm;          //!< The column permutation of m_oDeltaZ.
+	bool                  m_bDeltaPending;       //!< True if ApplyDeltaGauss has to be called.
+	bool                  m_bGaussTracking;      //!< True if the Gauss combinations are recorded.
+	const SystematicForm * m_pSystematicForm;    //!< The systematic form set by SetSystematicForm.
+	SharedBoard *         m_pBoard;              //!< The board set by SetBoard.
+	uint32_t              m_dBoardWorker;        //!< The index of this process on the board.
 	std::vector<uint64_t> m_vCombinedRows;       //!< Indices of the combined rows.
 	std::vector<uint64_t> m_vWeights;            //!< Weights for the bits of the code word.
 	RandomNumberGenerator m_oRnGen;              //!< Random number generator.
 	CodeWordFile          m_oOutputFile;         //!< Code word file object.
+	SearchStatistics      m_oStatistics;         //!< The statistics of the last search.
 
 	bool (*m_pCheckFunction)(CodeWord&);         //!< Pointer to the check function.
 
@@ -0,0 +1,90 @@
+/*!
+  \file MMTEngine.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class MMTEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef MMTENGINE_H_
+#define MMTENGINE_H_
+
+#include "types.h"
+#include "IsdEngine.h"
+
+//! The collision search of the algorithm by May, Meurer and Thomae.
+/*!
+  A candidate of up to 2p rows has many representations as the sum of
+  two combinations of up to p rows, hence it suffices to find one of
+  them. The window of sigma columns is split into l1 and l2 columns:\n
+  - The rows of Z are split into two halves and the combinations of up
+    to p/2 rows of each half are listed.
+  - The merge of the two lists keeps the sums whose projection onto the
+    l1 columns equals a random target. This gives one list of
+    combinations of up to p rows.
+  - Two combinations of this list with the same projection onto the l2
+    columns give a candidate whose projection onto the window is zero.\n
+  l1 is chosen such that the merged list has about the size of the
+  lists of the halves.
+
+  \see IsdEngine
+*/
+class MMTEngine : public IsdEngine {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	MMTEngine(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~MMTEngine(void);
+
+	//! Returns a new engine with the same parameters.
+	virtual IsdEngine * Clone() const;
+
+	//! Returns the name of the engine.
+	virtual const char * GetName() const;
+
+	//! Reads the parameters of the engine.
+	/*!
+	  A representation needs at least one row from each list, hence
+	  p has to be at least 2.
+	  \param oParameters The parameters.
+	  \return False if a value is not supported, an error is printed.
+	*/
+	virtual bool SetParameters(Parameters & oParameters);
+
+	//! Runs one iteration.
+	/*!
+	  \param oZ The Z part of the systematic generator matrix.
+	  \param oRnGen The random number generator of the chain.
+	  \param oCallback Receives the candidates.
+	*/
+	virtual void Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback);
+
+private:
+	IsdEngine::CombinationList m_oList1;  //!< The combinations of the first half.
+	IsdEngine::CombinationList m_oList2;  //!< The combinations of the second half.
+	IsdEngine::CombinationList m_oMerged; //!< The combinations with the target on the l1 columns.
+};
+
+#endif
@@ -0,0 +1,256 @@
+/*!
+  \file MatrixStorage.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class MatrixStorage.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef MATRIXSTORAGE_H_
+#define MATRIXSTORAGE_H_
+
+#include <cstring>
+#include <cstdlib>
+#include <cassert>
+#include <string>
+
+#include "types.h"
+
+//! This class holds the bits of a binary matrix in one contiguous block.
+/*!
+  All rows are stored row-major in a single allocation which is aligned
+  to a cache line. Every row occupies the same number of 64-bit words
+  (the stride). Rows which are at least half a cache line long are padded
+  to whole cache lines, shorter rows are padded to a power of two words,
+  such that no row straddles more cache lines than necessary.
+  Padding words are always zero.\n\n
+  A storage can also be a view of memory owned by another storage
+  (see MatrixStorage::Attach). Rows can not be added to or deleted from
+  a view, a copy of a view and a reshaped view own their data.
+  The rows can also be mapped from a file (see MatrixStorage::MapFile),
+  such that they are only read when they are accessed.\n\n
+  The class is used by CodeMatrix, which exposes the rows as CodeWord views.
+
+  \see CodeMatrix
+*/
+class MatrixStorage {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	MatrixStorage(void);
+
+	//! Copy constructor.
+	/*!
+	  Does a deep copy of the data.
+	  \param oOther The storage to copy.
+	*/
+	MatrixStorage(const MatrixStorage & oOther);
+
+	//! Move constructor.
+	/*!
+	  Takes the memory of the other storage, which is empty afterwards.
+	  \param oOther The storage to move.
+	*/
+	MatrixStorage(MatrixStorage && oOther) noexcept;
+
+	//! Destructor.
+	/*!
+	  Frees the allocated memory.
+	*/
+	virtual ~MatrixStorage(void);
+
+	//! Sets the shape of the storage.
+	/*!
+	  All data is discarded and dRows zero rows with
+	  dWords 64-bit words each are allocated. The memory
+	  is reused if it is large enough.
+	  \param dRows Number of rows.
+	  \param dWords Number of 64-bit words per row.
+	*/
+	void Reshape(uint64_t dRows, uint64_t dWords);
+
+	//! Makes the storage a view of rows owned by another storage.
+	/*!
+	  The memory is not freed by this storage.
+	  \param pData Pointer to the first row.
+	  \param dRows Number of rows.
+	  \param dWords Number of used 64-bit words per row.
+	  \param dStride Distance between two rows in 64-bit words.
+	*/
+	void Attach(uint64_t * pData, uint64_t dRows, uint64_t dWords, uint64_t dStride);
+
+	//! Returns true if the storage does not own its memory.
+	bool IsView() const;
+
+	//! Maps rows stored in a file.
+	/*!
+	  The whole file is mapped privately, i.e. changes are not written back.
+	  If rows are added the data is copied into allocated memory.
+	  Memory mapping is only supported on POSIX systems.
+	  \param sFileName The filename.
+	  \param dOffset Offset of the first row in the file in bytes.
+	  \param dRows Number of rows.
+	  \param dWords Number of used 64-bit words per row.
+	  \param dStride Distance between two rows in 64-bit words.
+	  \return Pointer to the start of the mapped file or NULL if
+	          the file could not be mapped.
+	*/
+	const char * MapFile(const std::string & sFileName, uint64_t dOffset,
+	                     uint64_t dRows, uint64_t dWords, uint64_t dStride);
+
+	//! Returns true if the rows are mapped from a file.
+	bool IsMapped() const;
+
+	//! Reserves memory for the given number of rows.
+	/*!
+	  The data is kept. Pointers returned by MatrixStorage::Row
+	  are invalid afterwards if the memory was reallocated.
+	  \param dRows Number of rows.
+	  \return True if the memory was reallocated.
+	*/
+	bool Reserve(uint64_t dRows);
+
+	//! Appends a zero row.
+	/*!
+	  \return True if the memory was reallocated.
+	*/
+	bool AddRow();
+
+	//! Changes the number of rows.
+	/*!
+	  New rows are zero, removed rows are cleared. The memory
+	  is only reallocated if the capacity is exceeded.
+	  \param dRows The new number of rows.
+	  \return True if the memory was reallocated.
+	*/
+	bool Resize(uint64_t dRows);
+
+	//! Exchanges the data of two rows.
+	/*!
+	  \param dRow1 The index of the first row.
+	  \param dRow2 The index of the second row.
+	*/
+	void SwapRows(uint64_t dRow1, uint64_t dRow2);
+
+	//! Exchanges the memory and the shape of two storages.
+	/*!
+	  \param oOther The other storage.
+	*/
+	void Swap(MatrixStorage & oOther) noexcept;
+
+	//! Deletes a row.
+	/*!
+	  All following rows are moved up by one.
+	  \param dRow The index of the row.
+	*/
+	void DeleteRow(uint64_t dRow);
+
+	//! Changes the number of used words per row.
+	/*!
+	  The stride is not changed, hence the number of words
+	  can only be reduced.
+	  \param dWords The new number of 64-bit words per row.
+	*/
+	void SetWords(uint64_t dWords);
+
+	//! Deletes all data.
+	void Clear();
+
+	//! Returns a pointer to the first word of a row.
+	/*!
+	  \param dRow The index of the row.
+	  \return Pointer to the row data.
+	*/
+	uint64_t * Row(uint64_t dRow);
+
+	//! Returns a pointer to the first word of a row.
+	/*!
+	  \param dRow The index of the row.
+	  \return Pointer to the row data.
+	*/
+	const uint64_t * Row(uint64_t dRow) const;
+
+	//! Returns the number of rows.
+	uint64_t GetRows() const;
+
+	//! Returns the number of used 64-bit words per row.
+	uint64_t GetWords() const;
+
+	//! Returns the distance between two rows in 64-bit words.
+	uint64_t GetStride() const;
+
+	//! Returns the stride used for rows of the given size.
+	/*!
+	  \param dWords Number of 64-bit words per row.
+	  \return The stride in 64-bit words.
+	*/
+	static uint64_t ComputeStride(uint64_t dWords);
+
+	//! Overloads the assignment operator.
+	/*!
+      The overloaded operator does a deep copy of the object. The memory
+	  is reused if it is owned and large enough for the rows of oOther.
+	  \param oOther The right hand side of the assignment.
+	  \return The left hand side of the assignment.
+	*/
+	MatrixStorage & operator=(const MatrixStorage & oOther);
+
+	//! Overloads the move assignment operator.
+	/*!
+	  The memory of oOther is taken, oOther is empty afterwards.
+	  \param oOther The right hand side of the assignment.
+	  \return The left hand side of the assignment.
+	*/
+	MatrixStorage & operator=(MatrixStorage && oOther) noexcept;
+
+	static const uint64_t CACHELINE = 64; //!< Alignment of the data in bytes.
+
+private:
+
+	//! Allocates zeroed memory aligned to a cache line.
+	/*!
+	  \param dWords Number of 64-bit words.
+	  \return Pointer to the memory.
+	*/
+	static uint64_t * Allocate(uint64_t dWords);
+
+	//! Frees the memory if it is owned and resets the storage.
+	void Release();
+
+	//! Frees the memory if it is owned, the shape is kept.
+	void FreeData();
+
+	//! Frees memory allocated with MatrixStorage::Allocate.
+	/*!
+	  \param pData Pointer to the memory.
+	*/
+	static void Free(uint64_t * pData);
+
+	uint64_t * m_pData;     //!< The matrix data.
+	uint64_t   m_dRows;     //!< Number of rows.
+	uint64_t   m_dCapacity; //!< Number of rows which fit in the allocated memory.
+	uint64_t   m_dWords;    //!< Number of used 64-bit words per row.
+	uint64_t   m_dStride;   //!< Number of 64-bit words between two rows.
+	bool       m_bView;     //!< True if the memory is owned by another storage.
+	void *     m_pMapping;  //!< Start of the mapped file or NULL.
+	uint64_t   m_dMappingSize; //!< Size of the mapped file in bytes.
+};
+
+#endif
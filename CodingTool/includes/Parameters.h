@@ -49,6 +49,19 @@
 	- Parameters::PERMUTE permute the columns of a generator matrix
 	- Parameters::CWFILE code word file for the input
 	- Parameters::CMFILE file containing a code matrix
+	- Parameters::THREADS number of parallel search chains
+	- Parameters::BINARYCW write binary records to the code word file
+	- Parameters::ALGORITHM information set decoding algorithm
+	- Parameters::P number of rows per combination
+	- Parameters::CHECKPOINT checkpoint file of the search
+	- Parameters::CHECKPOINTTIME seconds between two checkpoints
+	- Parameters::RESUME checkpoint file to resume from
+	- Parameters::STATISTICS statistics file of the search (JSON or CSV)
+	- Parameters::STATISTICSTIME seconds between two lines of the statistics file
+	- Parameters::SEED seed of the random number generators
+	- Parameters::CHECKMATRIX the code matrix is a parity-check matrix
+	- Parameters::BOARD shared memory board of a multi-process search
+	- Parameters::PIN pin the search chains to cores
 
   \see InputHandler
   \see LowWeightSearch
@@ -171,6 +184,19 @@ public:
 	static const std::string CWFILE;  //!< Code word file for input.
 	static const std::string CMFILE;  //!< File containing a code matrix.
 	static const std::string DOUTPUT; //!< Flag to disable the output.
+	static const std::string THREADS; //!< Number of parallel chains in LowWeightSearch::CanteautChabaud.
+	static const std::string BINARYCW; //!< Flag for binary records in the output code word file.
+	static const std::string ALGORITHM; //!< Information set decoding algorithm of LowWeightSearch::Search.
+	static const std::string P;       //!< Number of rows per combination of the IsdEngine.
+	static const std::string CHECKPOINT; //!< Checkpoint file of LowWeightSearch::Search.
+	static const std::string CHECKPOINTTIME; //!< Seconds between two checkpoints.
+	static const std::string RESUME;  //!< Checkpoint file from which LowWeightSearch::Search resumes.
+	static const std::string STATISTICS; //!< Statistics file of LowWeightSearch::Search.
+	static const std::string STATISTICSTIME; //!< Seconds between two lines of the statistics file.
+	static const std::string SEED;    //!< Seed of the random number generators of LowWeightSearch::Search.
+	static const std::string CHECKMATRIX; //!< Flag for a parity-check matrix, see LowWeightSearch::SearchCheck.
+	static const std::string BOARD;   //!< Name of the SharedBoard of a multi-process search.
+	static const std::string PIN;     //!< Flag for pinning the search chains to cores.
 
 private:
 
@@ -22,6 +22,7 @@
 // along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
 
 
+
 #ifndef RANDOMNUMBERGENERATOR_H_
 #define RANDOMNUMBERGENERATOR_H_
 
@@ -29,15 +30,17 @@
 #include <vector>
 #include <fstream>
 
-#include "mtrand.h"
 #include "types.h"
 
 //! This class provides access to a random number generator.
 /*!
-  The CodingTool does not implement its own random number
-  generator. Instead it is using the generator from
-  Makoto Matsumoto and Takuji Nishimura which was ported to
-  C++ by Jasper Bedaux (see http://www.bedaux.net/mtrand/).
+  The generator is xoshiro256** by David Blackman and Sebastiano
+  Vigna (see http://prng.di.unimi.it/). It has a state of 256 bits,
+  needs a few operations per 64-bit word and supports jumps, i.e.
+  RandomNumberGenerator::jump advances the generator by 2^128 words.
+  Starting from one seed, each search chain jumps once more than the
+  previous one, so the chains use independent streams and a search
+  can be repeated with the same seed (see Parameters::SEED).
   \n\n\n
   The purpose of this interface is to make the type
   of random number generator easy exchangeable.
@@ -52,6 +55,14 @@ public:
 	  Windows machines.
 	*/
 	RandomNumberGenerator();
+
+    //! Constructor.
+	/*!
+	  The constructor initializes the random number generator
+	  with the given seed.
+	  \param dSeed The seed.
+	*/
+	explicit RandomNumberGenerator(uint64_t dSeed);
 	
 	//! Destructor.
 	/*!
@@ -59,10 +70,17 @@ public:
 	*/
 	virtual ~RandomNumberGenerator();
 
+	//! Returns a random 64-bit word.
+	/*!
+	  \return A random word.
+	*/
+	uint64_t getRandom64();
+
 	//! Returns a positive integer.
 	/*!
-      This method returns a random integer between 0 and n.
-	  \param n Maximum random number.
+      This method returns a random integer between 0 and n-1.
+	  All values have the same probability.
+	  \param n Number of possible values, larger than zero.
 	  \return A random number.
 	*/
 	uint64_t getRandomPosInteger(uint64_t n);
@@ -71,24 +89,71 @@ public:
 	/*!
       This method returns a vector of random integers from
 	  the closed interval [lb,ub]. The vector does not contain duplicates.
+	  Small samples are drawn with Floyd's algorithm from ln random numbers,
+	  large samples (e.g. a permutation of the whole interval) with a
+	  partial Fisher-Yates shuffle. The order of the elements is only
+	  random for the shuffle.
 
 	  \param lb Lower bound for the random numbers.
 	  \param ub Upper bound for the random numbers.
-	  \param ln Number of random numbers.
+	  \param ln Number of random numbers, at most ub-lb+1.
 	  \return A vector with random numbers.
 	*/
 	std::vector<uint64_t> getRandomPosVector(uint64_t lb,
 											 uint64_t ub, uint64_t ln);
+
+	//! Computes a vector of positive integers.
+	/*!
+      Draws the same numbers as the method above, but writes them to
+	  the given vector, whose memory is reused. Repeated calls with the
+	  same bounds do not allocate memory, except for samples of more
+	  than 64 numbers from a large interval.
+
+	  \param lb Lower bound for the random numbers.
+	  \param ub Upper bound for the random numbers.
+	  \param ln Number of random numbers, at most ub-lb+1.
+	  \param vReturn Returns the random numbers.
+	*/
+	void getRandomPosVector(uint64_t lb, uint64_t ub, uint64_t ln,
+	                        std::vector<uint64_t> & vReturn);
 	
     //! Returns the seed of the generator.
 	/*!
-      \return The 32-bit word seed.
+      \return The seed.
+	*/
+	uint64_t getSeed();
+
+    //! Seeds the generator.
+	/*!
+      The state is derived from the seed with SplitMix64.
+	  \param dSeed The seed.
+	*/
+	void setSeed(uint64_t dSeed);
+
+    //! Advances the generator by 2^128 words.
+	/*!
+      Generators which are seeded with the same seed and jumped a
+	  different number of times produce non-overlapping sequences.
 	*/
-	uint32_t getSeed();
+	void jump();
+
+    //! Returns the state of the generator.
+	/*!
+      \param pState Returns the STATEWORDS words of the state.
+	*/
+	void getState(uint64_t * pState);
+
+    //! Restores a state of the generator, see getState.
+	/*!
+	  \param pState The STATEWORDS words of the state.
+	*/
+	void setState(const uint64_t * pState);
+
+	static const uint32_t STATEWORDS = 4; //!< Number of 64-bit words of the state.
 private:
 		
-	MTRand_int32 m_oGenerator; //!< The random number generator
-	uint32_t	 m_dSeed;      //!< The seed.
+	uint64_t	 m_aState[STATEWORDS]; //!< The state of xoshiro256**.
+	uint64_t	 m_dSeed;      //!< The seed.
 };
 
 #endif /*RANDOMNUMBERGENERATOR_H_*/
@@ -0,0 +1,101 @@
+/*!
+  \file RowKernels.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file defining the kernels for operations on
+         rows of 64-bit words.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROWKERNELS_H_
+#define ROWKERNELS_H_
+
+#include "types.h"
+
+//! The implementations of the row kernels.
+/*!
+  The best implementation supported by the CPU is selected
+  at the first call of a kernel (KERNEL_AUTO).
+*/
+enum KernelType {
+	KERNEL_AUTO,    //!< Selects the fastest supported kernel.
+	KERNEL_SCALAR,  //!< Portable C++ implementation.
+	KERNEL_POPCNT,  //!< Uses the SSE4.2 POPCNT instruction.
+	KERNEL_AVX2,    //!< Uses 256-bit AVX2 registers.
+	KERNEL_AVX512   //!< Uses 512-bit registers and AVX-512 VPOPCNTQ.
+};
+
+//! Selects the implementation of the row kernels.
+/*!
+  \param eType The implementation.
+  \return False if the CPU does not support the implementation.
+          In that case the selection is not changed.
+*/
+bool SetRowKernel(KernelType eType);
+
+//! Returns the implementation of the row kernels in use.
+/*!
+  \return The implementation.
+*/
+KernelType GetRowKernel();
+
+//! Returns the name of the implementation of the row kernels in use.
+/*!
+  \return The name.
+*/
+const char * GetRowKernelName();
+
+//! Computes the Hamming weight of a row.
+/*!
+  \param pData Pointer to the row.
+  \param dWords Number of 64-bit words of the row.
+  \return The Hamming weight.
+*/
+uint64_t RowWeight(const uint64_t * pData, uint64_t dWords);
+
+//! Xors a row to another row and computes the Hamming weight of the result.
+/*!
+  Both operations are done in one pass over the data.
+  \param pDst Pointer to the row which is changed.
+  \param pSrc Pointer to the row which is added.
+  \param dWords Number of 64-bit words of the rows.
+  \return The Hamming weight of the new pDst.
+*/
+uint64_t RowXorWeight(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords);
+
+//! Computes the Hamming weight of the xor of several rows.
+/*!
+  The rows are not changed and the xor is not stored. The weight is
+  accumulated in chunks of ROWCHUNK words and the computation stops
+  after the first chunk at which the weight reaches the bound.
+  \param ppRows Pointers to the rows.
+  \param dRows Number of rows, at most MAXXORROWS.
+  \param dWords Number of 64-bit words of the rows.
+  \param dBound The bound.
+  \return The Hamming weight if it is smaller than dBound,
+          otherwise a value which is at least dBound.
+*/
+uint64_t RowsXorWeight(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound);
+
+//! Largest number of rows supported by RowsXorWeight.
+const uint32_t MAXXORROWS = 8;
+
+//! Number of 64-bit words after which RowsXorWeight checks the bound.
+const uint64_t ROWCHUNK = 8;
+
+#endif
@@ -0,0 +1,116 @@
+/*!
+  \file SearchStatistics.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class SearchStatistics.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef SEARCHSTATISTICS_H_
+#define SEARCHSTATISTICS_H_
+
+#include <ostream>
+#include <string>
+
+#include "types.h"
+
+//! Counters and timers of the low weight search.
+/*!
+  Each search chain and each IsdEngine counts into its own object,
+  LowWeightSearch::Search adds them up after every iteration. All
+  times are in nanoseconds. The phases are:
+  - project, GetSubMatrix of the random window (IsdEngine::Project)
+  - enumerate, the lists of row combinations (IsdEngine::Enumerate)
+  - collide, the hash table and the collision checks, including the
+    candidates (IsdEngine::Collide)
+  - candidates, the weight of the candidates, estimated from every
+    SAMPLE-th candidate
+  - build, the code words of new minima (LowWeightSearch::BuildMinVector)
+  - delta gauss, the pivot step (LowWeightSearch::DeltaGauss)
+
+  The statistics can be written periodically as JSON (one object per
+  line) or as CSV (see Parameters::STATISTICS).
+
+  \see LowWeightSearch
+  \see IsdEngine
+*/
+struct SearchStatistics {
+	uint64_t dIterations;     //!< Number of finished iterations.
+	uint64_t dCombinations;   //!< Number of listed row combinations.
+	uint64_t dCollisions;     //!< Number of pairs of combinations with the same key.
+	uint64_t dCandidates;     //!< Number of candidates whose weight was computed.
+	uint64_t dEarlyAborts;    //!< Candidates whose weight computation stopped at the current minimum.
+	uint64_t dImprovements;   //!< Number of new minima.
+	uint64_t dIndexMemory;    //!< Largest memory of the hash table of one chain in bytes.
+	uint64_t dProjectTime;    //!< Time of the projections.
+	uint64_t dEnumerateTime;  //!< Time of the enumeration.
+	uint64_t dCollideTime;    //!< Time of the collision search, including the candidates.
+	uint64_t dCandidateTime;  //!< Estimated time of the weight computation of the candidates.
+	uint64_t dBuildTime;      //!< Time of LowWeightSearch::BuildMinVector.
+	uint64_t dDeltaGaussTime; //!< Time of LowWeightSearch::DeltaGauss.
+
+	static const uint64_t SAMPLE = 64;  //!< Only every SAMPLE-th candidate is timed.
+
+	//! Constructor.
+	/*!
+	  All counters are zero.
+	*/
+	SearchStatistics(void);
+
+	//! Sets all counters to zero.
+	void Clear();
+
+	//! Adds the counters of another object.
+	/*!
+	  The memory of the hash table is the maximum of both.
+	  \param oOther The statistics to add.
+	*/
+	void Add(const SearchStatistics & oOther);
+
+	//! Returns a monotonic time stamp in nanoseconds.
+	static uint64_t Now();
+
+	//! Writes the statistics as one line of JSON.
+	/*!
+	  \param oStream The stream.
+	  \param dSeconds Elapsed time of the search in seconds.
+	  \param dMinWeight The current minimum weight.
+	*/
+	void WriteJson(std::ostream & oStream, double dSeconds, uint64_t dMinWeight) const;
+
+	//! Writes the header line of the CSV format.
+	/*!
+	  \param oStream The stream.
+	*/
+	static void WriteCsvHeader(std::ostream & oStream);
+
+	//! Writes the statistics as one line of CSV.
+	/*!
+	  \param oStream The stream.
+	  \param dSeconds Elapsed time of the search in seconds.
+	  \param dMinWeight The current minimum weight.
+	*/
+	void WriteCsv(std::ostream & oStream, double dSeconds, uint64_t dMinWeight) const;
+
+	//! Prints a summary to std::cout.
+	/*!
+	  \param dSeconds Elapsed time of the search in seconds.
+	*/
+	void Print(double dSeconds) const;
+};
+
+#endif
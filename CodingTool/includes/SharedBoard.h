@@ -0,0 +1,209 @@
+/*!
+  \file SharedBoard.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class SharedBoard.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef SHAREDBOARD_H_
+#define SHAREDBOARD_H_
+
+#include <string>
+#include <iostream>
+
+#include "types.h"
+#include "CodeWord.h"
+
+//! A board in POSIX shared memory which is shared by several search processes.
+/*!
+  A multi-process search consists of one coordinator, which creates the
+  board (SharedBoard::Create), and several workers, e.g. one search
+  process per NUMA node. Each worker attaches to the board
+  (SharedBoard::Attach) and passes it to LowWeightSearch::SetBoard.
+  The board holds:
+  - the global minimum weight and the code word with that weight,
+  - the progress of each worker (iterations, minimum, last update),
+  - a stop flag for all workers.
+
+  The workers prune their candidates with the global minimum and offer
+  their new minima to the board (SharedBoard::Offer). They do not write
+  code word files, the coordinator writes each new global minimum to a
+  single file and prints the progress of all workers
+  (SharedBoard::Print). Everything runs on one Linux host, the board is
+  the segment /dev/shm/<name> and no other service is needed.\n\n
+  The counters are lock-free atomics, the code word is copied under a
+  spin lock in the segment. A worker which terminates without
+  SharedBoard::Leave is detected by its process id.
+
+  \see LowWeightSearch::SetBoard
+  \see coordinator.cpp
+*/
+class SharedBoard {
+public:
+	//! The progress of one worker.
+	struct WorkerInfo {
+		uint64_t dPid;          //!< The process id.
+		uint64_t dState;        //!< SharedBoard::FREE, SharedBoard::RUNNING or SharedBoard::FINISHED.
+		uint64_t dIterations;   //!< Number of finished iterations.
+		uint64_t dMinWeight;    //!< The minimum weight found by the worker.
+		uint64_t dUpdated;      //!< Time of the last update (SearchStatistics::Now).
+	};
+
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	SharedBoard(void);
+
+	//! Destructor.
+	/*!
+	  Detaches from the board.
+	*/
+	virtual ~SharedBoard(void);
+
+	//! Creates a new board.
+	/*!
+	  The segment is removed by SharedBoard::Detach of the creator.
+	  \param sName The name of the board.
+	  \param dLength The length of the code.
+	  \param dMaxWorkers The largest number of workers.
+	  \return False if the board exists or can not be created, an error is printed.
+	*/
+	bool Create(const std::string & sName, uint64_t dLength, uint32_t dMaxWorkers = MAXWORKERS);
+
+	//! Attaches to an existing board.
+	/*!
+	  \param sName The name of the board.
+	  \param dLength The length of the code, it has to be the same as the one of the board.
+	  \return False if the board does not exist or does not match, an error is printed.
+	*/
+	bool Attach(const std::string & sName, uint64_t dLength);
+
+	//! Detaches from the board, the creator removes it.
+	void Detach();
+
+	//! Returns true if the object is attached to a board.
+	bool IsAttached() const;
+
+	//! Registers the calling process as a worker.
+	/*!
+	  \return The index of the worker or SharedBoard::MAXWORKERS if
+	          the board is full, an error is printed.
+	*/
+	uint32_t Join();
+
+	//! Marks a worker as finished.
+	/*!
+	  \param dWorker The index of the worker.
+	*/
+	void Leave(uint32_t dWorker);
+
+	//! Updates the progress of a worker.
+	/*!
+	  \param dWorker The index of the worker.
+	  \param dIterations Number of finished iterations.
+	  \param dMinWeight The minimum weight found by the worker.
+	*/
+	void SetProgress(uint32_t dWorker, uint64_t dIterations, uint64_t dMinWeight);
+
+	//! Returns the progress of a worker.
+	/*!
+	  A worker whose process does not exist anymore is returned as finished.
+	  \param dWorker The index of the worker.
+	*/
+	WorkerInfo GetWorker(uint32_t dWorker) const;
+
+	//! Returns the number of workers which joined the board.
+	uint32_t GetWorkers() const;
+
+	//! Returns true if all workers which joined the board are finished.
+	bool IsFinished() const;
+
+	//! Returns the global minimum weight.
+	uint64_t GetBestWeight() const;
+
+	//! Offers a code word to the board.
+	/*!
+	  \param oCodeWord The code word.
+	  \param dWeight The weight of the code word.
+	  \return True if the weight is lower than the global minimum, the
+	          code word is stored.
+	*/
+	bool Offer(const CodeWord & oCodeWord, uint64_t dWeight);
+
+	//! Returns the code word with the global minimum weight.
+	/*!
+	  \param oCodeWord Returns the code word, it is empty if no code word was offered.
+	  \return The number of improvements of the global minimum, it changes
+	          whenever a new code word is stored.
+	*/
+	uint64_t GetBest(CodeWord & oCodeWord) const;
+
+	//! Returns the number of improvements of the global minimum.
+	uint64_t GetGeneration() const;
+
+	//! Asks all workers to stop.
+	void Stop();
+
+	//! Returns true if the workers should stop.
+	bool IsStopped() const;
+
+	//! Prints the progress of all workers.
+	/*!
+	  The iterations per second are computed from the previous call.
+	  \param oStream The output stream.
+	*/
+	void Print(std::ostream & oStream);
+
+	static const uint32_t MAXWORKERS = 64;  //!< Default largest number of workers.
+	static const uint64_t FREE       = 0;   //!< State of an unused worker slot.
+	static const uint64_t RUNNING    = 1;   //!< State of a running worker.
+	static const uint64_t FINISHED   = 2;   //!< State of a finished worker.
+
+private:
+	struct Header;
+	struct Worker;
+
+	//! Maps the segment.
+	/*!
+	  \param iFile The file descriptor.
+	  \param dSize The size of the segment.
+	  \return False if an error is printed.
+	*/
+	bool Map(int iFile, uint64_t dSize);
+
+	//! Acquires the spin lock of the code word.
+	void Lock() const;
+
+	//! Releases the spin lock of the code word.
+	void Unlock() const;
+
+	//! Returns the size of a segment.
+	static uint64_t SegmentSize(uint64_t dLength, uint32_t dMaxWorkers);
+
+	std::string m_sName;          //!< The name of the segment.
+	void *      m_pSegment;       //!< The mapped segment.
+	uint64_t    m_dSize;          //!< The size of the segment.
+	Header *    m_pHeader;        //!< The header at the start of the segment.
+	Worker *    m_pWorkers;       //!< The worker slots after the header.
+	bool        m_bCreator;       //!< True if the object created the board.
+	uint64_t    m_dLastIterations; //!< Total iterations at the previous SharedBoard::Print.
+	uint64_t    m_dLastTime;      //!< Time of the previous SharedBoard::Print.
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*!
+  \file SternEngine.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class SternEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef STERNENGINE_H_
+#define STERNENGINE_H_
+
+#include "types.h"
+#include "IsdEngine.h"
+
+//! The collision search of Stern's algorithm.
+/*!
+  The rows of Z are split into two halves. All combinations of
+  exactly p rows (Parameters::P) of each half are projected onto a
+  random window of l = sigma columns (Parameters::SIGMA), and
+  combinations of the two halves with the same projection are
+  candidates of 2p rows.
+
+  \see IsdEngine
+*/
+class SternEngine : public IsdEngine {
+public:
+	//! Constructor.
+	/*!
+	  Does nothing special.
+	*/
+	SternEngine(void);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~SternEngine(void);
+
+	//! Returns a new engine with the same parameters.
+	virtual IsdEngine * Clone() const;
+
+	//! Returns the name of the engine.
+	virtual const char * GetName() const;
+
+	//! Runs one iteration.
+	/*!
+	  \param oZ The Z part of the systematic generator matrix.
+	  \param oRnGen The random number generator of the chain.
+	  \param oCallback Receives the candidates.
+	*/
+	virtual void Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback);
+
+private:
+	IsdEngine::CombinationList m_oList1;  //!< The combinations of the first half.
+	IsdEngine::CombinationList m_oList2;  //!< The combinations of the second half.
+};
+
+#endif
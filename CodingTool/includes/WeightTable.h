@@ -0,0 +1,154 @@
+/*!
+  \file WeightTable.h
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This is the header file of the class WeightTable.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef WEIGHTTABLE_H_
+#define WEIGHTTABLE_H_
+
+#include <vector>
+
+#include "types.h"
+#include "HammingWeight.h"
+
+//! Computes weighted Hamming weights of rows with a few operations per word.
+/*!
+  Each bit of a row has its own weight, bit i is the column i of the
+  row (the most significant bit of word i/64 is column 64*(i/64)). The
+  weights are preprocessed in one of two ways:
+  - If there are at most MAXCLASSES different non-zero weights, the bits
+    of each word are split into weight classes with one mask per class.
+    The weight of a word is the sum of the popcounts of the masked word
+    times the class weights, e.g. two popcounts if message bits and
+    state bits are weighted differently.
+  - Otherwise each word has eight tables of 256 partial sums, one for
+    each byte. The weight of a word is the sum of eight table entries.
+
+  WeightTable::SetWeight changes the weight of one bit and updates only
+  the mask or the table of its word, hence the columns can be swapped
+  cheaply (see LowWeightSearch::DeltaGauss).
+
+  \see CodeMatrix::XorWeight
+  \see LowWeightSearch::SetWeightVector
+*/
+class WeightTable {
+public:
+	//! Constructor.
+	/*!
+	  Creates an empty table.
+	*/
+	WeightTable(void);
+
+	//! Constructor.
+	/*!
+	  \param vWeights The weight of each bit.
+	*/
+	WeightTable(const std::vector<uint64_t> & vWeights);
+
+	//! Destructor.
+	/*!
+	  Does nothing special.
+	*/
+	virtual ~WeightTable(void);
+
+	//! Sets the weights of all bits.
+	/*!
+	  \param vWeights The weight of each bit.
+	*/
+	void SetWeights(const std::vector<uint64_t> & vWeights);
+
+	//! Sets the weight of one bit.
+	/*!
+	  \param dBit The index of the bit.
+	  \param dWeight The weight.
+	*/
+	void SetWeight(uint64_t dBit, uint64_t dWeight);
+
+	//! Returns the weight of one bit.
+	/*!
+	  \param dBit The index of the bit.
+	  \return The weight.
+	*/
+	uint64_t GetWeight(uint64_t dBit) const;
+
+	//! Returns the weighted Hamming weight of one word of a row.
+	/*!
+	  \param dData The word.
+	  \param dWord The index of the word in the row.
+	  \return The weighted Hamming weight.
+	*/
+	uint64_t Weight(uint64_t dData, uint64_t dWord) const {
+		uint64_t dWeight = 0;
+		if(!m_bTables) {
+			const uint64_t * pMasks = &m_vMasks[dWord*MAXCLASSES];
+			for(uint32_t c = 0; c < m_dClasses; c++)
+				dWeight += m_aClassWeights[c]*HammingWeight(dData & pMasks[c]);
+			return dWeight;
+		}
+		const uint64_t * pTables = &m_vTables[dWord*8*256];
+		for(uint32_t b = 0; b < 8; b++)
+			dWeight += pTables[b*256 + ((dData >> (56-8*b)) & 0xFF)];
+		return dWeight;
+	}
+
+	//! Returns the weighted Hamming weight of a row.
+	/*!
+	  \param pData Pointer to the row.
+	  \param dWords Number of 64-bit words, at most WeightTable::GetWords.
+	  \return The weighted Hamming weight.
+	*/
+	uint64_t Weight(const uint64_t * pData, uint64_t dWords) const;
+
+	//! Returns the number of bits.
+	uint64_t GetBits() const;
+
+	//! Returns the number of 64-bit words.
+	uint64_t GetWords() const;
+
+	//! Returns true if the byte tables are used instead of the weight classes.
+	bool UsesTables() const;
+
+	static const uint32_t MAXCLASSES = 4;  //!< Largest number of weight classes.
+
+private:
+	//! Chooses the representation and builds the masks or tables of all words.
+	void Build();
+
+	//! Builds the masks of one word.
+	/*!
+	  \param dWord The index of the word.
+	*/
+	void BuildMasks(uint64_t dWord);
+
+	//! Builds the table of one byte.
+	/*!
+	  \param dByte The index of the byte.
+	*/
+	void BuildTable(uint64_t dByte);
+
+	std::vector<uint64_t> m_vWeights;       //!< The weight of each bit.
+	std::vector<uint64_t> m_vMasks;         //!< MAXCLASSES masks per word.
+	std::vector<uint64_t> m_vTables;        //!< 256 partial sums per byte.
+	uint64_t              m_aClassWeights[MAXCLASSES]; //!< The weights of the classes.
+	uint32_t              m_dClasses;       //!< Number of weight classes.
+	bool                  m_bTables;        //!< True if the tables are used.
+};
+
+#endif
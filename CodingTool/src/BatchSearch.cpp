@@ -0,0 +1,288 @@
+/*!
+  \file BatchSearch.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class BatchSearch.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "BatchSearch.h"
+
+BatchSearch::BatchSearch(void) {
+}
+
+BatchSearch::~BatchSearch(void) {
+	std::map<std::string, Code*>::iterator iCode;
+	std::map<std::string, CodeMatrix*>::iterator iMatrix;
+
+	for(iCode = m_mCodes.begin(); iCode != m_mCodes.end(); iCode++)
+		delete iCode->second;
+	for(iMatrix = m_mMatrices.begin(); iMatrix != m_mMatrices.end(); iMatrix++)
+		delete iMatrix->second;
+}
+
+bool
+BatchSearch::ReadManifest(const std::string & sFileName) {
+	std::ifstream oFile(sFileName.c_str());
+	std::string sLine;
+	uint64_t dLine = 0;
+
+	if(oFile.fail()) {
+		std::cout << "Error: The file " << sFileName << " does not exist." << std::endl;
+		return false;
+	}
+
+	while(std::getline(oFile, sLine)) {
+		std::istringstream sStream(sLine);
+		std::string sColumns, sArgument;
+		Job oJob;
+
+		dLine++;
+		if(!(sStream >> oJob.sName) || oJob.sName[0] == '#')
+			continue;
+		if(!(sStream >> oJob.sMatrix >> sColumns >> oJob.sWeights)) {
+			std::cout << "Error: Line " << dLine << " of " << sFileName << " has less than four fields." << std::endl;
+			return false;
+		}
+
+		if(sColumns != "-") {
+			std::istringstream sColumnStream(sColumns);
+			uint64_t dColumn = 0;
+			char cSeparator  = ',';
+			while(cSeparator == ',' && sColumnStream >> dColumn) {
+				oJob.vColumns.push_back(dColumn);
+				cSeparator = 0;
+				sColumnStream >> cSeparator;
+			}
+			if(!sColumnStream.eof() || oJob.vColumns.size() == 0) {
+				std::cout << "Error: Line " << dLine << " of " << sFileName << " has invalid columns." << std::endl;
+				return false;
+			}
+		}
+		if(oJob.sWeights == "-")
+			oJob.sWeights = "";
+
+		while(sStream >> sArgument)
+			oJob.vArguments.push_back(sArgument);
+
+		oJob.sKey     = oJob.sMatrix + " " + sColumns;
+		oJob.bDone    = false;
+		oJob.dWeight  = 0;
+		oJob.dSeconds = 0;
+		m_vJobs.push_back(oJob);
+	}
+	return true;
+}
+
+uint64_t
+BatchSearch::GetJobs() const {
+	return m_vJobs.size();
+}
+
+uint64_t
+BatchSearch::Run(uint64_t dThreads, const std::string & sSummary) {
+	std::vector<std::thread> vThreads;
+	uint64_t dFailed = 0;
+	uint64_t i = 0;
+
+	if(dThreads == 0)
+		dThreads = std::thread::hardware_concurrency();
+	if(dThreads == 0)
+		dThreads = 1;
+	if(dThreads > m_vJobs.size())
+		dThreads = m_vJobs.size();
+
+	// the jobs are dealt round robin, idle workers steal the rest
+	for(i = 0; i < dThreads; i++)
+		m_vQueues.push_back(new Queue);
+	for(i = 0; i < m_vJobs.size(); i++)
+		m_vQueues[i%dThreads]->dJobs.push_back(i);
+
+	std::cout << "Info: Running " << m_vJobs.size() << " jobs on " << dThreads << " threads" << std::endl;
+	for(i = 1; i < dThreads; i++)
+		vThreads.push_back(std::thread(&BatchSearch::Work, this, i));
+	if(dThreads > 0)
+		Work(0);
+	for(i = 0; i < vThreads.size(); i++)
+		vThreads[i].join();
+
+	for(i = 0; i < m_vQueues.size(); i++)
+		delete m_vQueues[i];
+	m_vQueues.clear();
+
+	std::ofstream oSummary(sSummary.c_str(), std::ios::out | std::ios::trunc);
+	if(oSummary.fail())
+		std::cout << "Error: The file " << sSummary << " can not be written." << std::endl;
+	oSummary << "# name\tmatrix\tweight\tseconds" << std::endl;
+	for(i = 0; i < m_vJobs.size(); i++) {
+		oSummary << m_vJobs[i].sName << "\t" << m_vJobs[i].sMatrix << "\t";
+		if(m_vJobs[i].bDone)
+			oSummary << m_vJobs[i].dWeight;
+		else {
+			oSummary << "-";
+			dFailed++;
+		}
+		oSummary << "\t" << m_vJobs[i].dSeconds << std::endl;
+	}
+	return dFailed;
+}
+
+void
+BatchSearch::Work(uint64_t dWorker) {
+	uint64_t dJob = 0;
+
+	while(NextJob(dWorker, dJob))
+		RunJob(m_vJobs[dJob]);
+}
+
+bool
+BatchSearch::NextJob(uint64_t dWorker, uint64_t & dJob) {
+	// the own queue is used from the front, others from the back
+	for(uint64_t i = 0; i < m_vQueues.size(); i++) {
+		Queue & oQueue = *m_vQueues[(dWorker+i)%m_vQueues.size()];
+		std::lock_guard<std::mutex> oLock(oQueue.oMutex);
+		if(oQueue.dJobs.empty())
+			continue;
+		if(i == 0) {
+			dJob = oQueue.dJobs.front();
+			oQueue.dJobs.pop_front();
+		}
+		else {
+			dJob = oQueue.dJobs.back();
+			oQueue.dJobs.pop_back();
+		}
+		return true;
+	}
+	return false;
+}
+
+void
+BatchSearch::RunJob(Job & oJob) {
+	std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+	std::vector<const char*> vArgv;
+	std::vector<uint64_t> vWeights;
+	Parameters oParameters;
+	InputHandler oInputHandler(oParameters);
+	LowWeightSearch oLowWS;
+	CodeWord oCodeWord;
+
+	// defaults of a job, the arguments of the manifest overwrite them
+	oParameters.SetParameter(Parameters::OUTPUT, oJob.sName + ".cw");
+	oParameters.SetParameter(Parameters::DOUTPUT, 1);
+	vArgv.push_back("batch");
+	for(uint64_t i = 0; i < oJob.vArguments.size(); i++)
+		vArgv.push_back(oJob.vArguments[i].c_str());
+	if(vArgv.size() > 1 && oInputHandler.ParseSettings(vArgv.size(), &vArgv[0])) {
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		std::cout << "Error: Job " << oJob.sName << " has invalid arguments." << std::endl;
+		return;
+	}
+
+	if(oJob.sWeights != "") {
+		std::ifstream oFile(oJob.sWeights.c_str());
+		uint64_t dWeight = 0;
+		while(oFile >> dWeight)
+			vWeights.push_back(dWeight);
+		if(vWeights.size() == 0) {
+			std::lock_guard<std::mutex> oLock(m_oMutex);
+			std::cout << "Error: Job " << oJob.sName << " can not read the weights " << oJob.sWeights << "." << std::endl;
+			return;
+		}
+		oLowWS.SetWeightVector(vWeights);
+	}
+
+	Code & oCode = GetCode(oJob);
+	if(!oCode.bValid) {
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		std::cout << "Error: Job " << oJob.sName << " has no valid matrix." << std::endl;
+		return;
+	}
+
+	oLowWS.SetSystematicForm(&oCode.oForm);
+	oCodeWord = oLowWS.Search(oCode.oGenerator, oParameters);
+
+	std::lock_guard<std::mutex> oLock(m_oMutex);
+	oJob.dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-tStart).count();
+	oJob.bDone    = oCodeWord.GetLength() > 0;
+	// the same weight as minimized by the search, see LowWeightSearch::SetWeightVector
+	oJob.dWeight  = vWeights.size() > 0 ? oCodeWord.GetHammingWeight(vWeights) : oCodeWord.GetHammingWeight();
+	std::cout << "Info: Job " << oJob.sName << " finished, " << (vWeights.size() > 0 ? "weighted Hamming" : "Hamming")
+	          << " weight is " << oJob.dWeight << std::endl;
+}
+
+BatchSearch::Code &
+BatchSearch::GetCode(Job & oJob) {
+	Code * pCode = NULL;
+
+	{
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		if(m_mCodes.find(oJob.sKey) == m_mCodes.end()) {
+			pCode = new Code;
+			pCode->bReady   = false;
+			pCode->bValid   = false;
+			m_mCodes[oJob.sKey] = pCode;
+		}
+		pCode = m_mCodes[oJob.sKey];
+	}
+
+	// the first job prepares the code, the others wait for the lock
+	std::lock_guard<std::mutex> oLock(pCode->oMutex);
+	if(!pCode->bReady) {
+		LowWeightSearch oLowWS;
+		CodeMatrix oMatrix;
+
+		GetMatrix(oJob.sMatrix, oMatrix);
+		if(oJob.vColumns.size() > 0 && oMatrix.GetRows() > 0)
+			pCode->oGenerator = oLowWS.CodeShortening(oMatrix, oJob.vColumns);
+		else
+			pCode->oGenerator = oMatrix;
+
+		pCode->bValid = pCode->oGenerator.GetRows() > 0 && pCode->oGenerator.GetColumns() > 0;
+		if(pCode->bValid)
+			oLowWS.ComputeSystematicForm(pCode->oGenerator, pCode->oForm);
+		pCode->bReady = true;
+	}
+	return *pCode;
+}
+
+void
+BatchSearch::GetMatrix(const std::string & sFileName, CodeMatrix & oMatrix) {
+	CodeMatrix * pMatrix = NULL;
+
+	{
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		if(m_mMatrices.find(sFileName) != m_mMatrices.end()) {
+			oMatrix = *m_mMatrices[sFileName];
+			return;
+		}
+	}
+
+	// the file is read without the lock, another job may read it as well
+	pMatrix = new CodeMatrix;
+	pMatrix->ReadFromFile(sFileName);
+	oMatrix = *pMatrix;
+
+	std::lock_guard<std::mutex> oLock(m_oMutex);
+	if(m_mMatrices.find(sFileName) == m_mMatrices.end())
+		m_mMatrices[sFileName] = pMatrix;
+	else
+		delete pMatrix;
+}
+
+//EOF
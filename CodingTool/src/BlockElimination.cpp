@@ -0,0 +1,338 @@
+/*!
+  \file BlockElimination.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class BlockElimination.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+
+#include "BlockElimination.h"
+#include "RowKernels.h"
+
+// size of the part of the table which is used at once
+static const uint64_t STRIPE_BYTES = 1 << 17;
+
+static const uint64_t TOP = static_cast<uint64_t>(1) << 63;
+
+BlockElimination::BlockElimination(void)
+  : m_dColumns(0), m_dWords(0), m_dAttached(0), m_dFirstWord(0), m_dBlockSize(0) {
+}
+
+BlockElimination::~BlockElimination(void) {
+}
+
+void
+BlockElimination::Load(CodeMatrix & oMatrix, CodeMatrix * pAttached) {
+	uint64_t dRows = oMatrix.GetRows();
+	uint64_t dAttachedWords = 0;
+
+	m_dColumns  = oMatrix.GetColumns();
+	m_dWords    = oMatrix.GetColumns64();
+	m_dAttached = 0;
+	if(pAttached != NULL) {
+		assert(pAttached->GetRows() == dRows);
+		m_dAttached    = pAttached->GetColumns();
+		dAttachedWords = pAttached->GetColumns64();
+	}
+
+	m_oData.Reshape(dRows, m_dWords+dAttachedWords);
+	for(uint64_t i = 0; i < dRows; i++) {
+		memcpy(m_oData.Row(i), oMatrix.m_oStorage.Row(i), m_dWords*sizeof(uint64_t));
+		if(pAttached != NULL)
+			memcpy(m_oData.Row(i)+m_dWords, pAttached->m_oStorage.Row(i), dAttachedWords*sizeof(uint64_t));
+	}
+
+	m_vOrder.resize(dRows);
+	for(uint64_t i = 0; i < dRows; i++)
+		m_vOrder[i] = i;
+	m_vColsPerm.resize(m_dColumns);
+	for(uint64_t i = 0; i < m_dColumns; i++)
+		m_vColsPerm[i] = i;
+	m_vProj.assign(dRows, 0);
+	m_vIndex.assign(dRows, 0);
+}
+
+void
+BlockElimination::SetBlockSize(uint32_t dBlockSize) {
+	m_dBlockSize = dBlockSize < MAXBLOCK ? dBlockSize : MAXBLOCK;
+}
+
+uint64_t
+BlockElimination::Eliminate(const std::vector<uint64_t> & vColumns, bool bStable, bool bSwapColumns) {
+	uint64_t dRows = m_oData.GetRows();
+	uint64_t dRank = 0;
+	uint64_t r     = 0;
+	uint32_t k     = m_dBlockSize;
+	bool     bPrefix = bSwapColumns;
+	std::vector<Pivot>    vPivots;
+	std::vector<uint64_t> vBlock;
+	ColumnGather          oGather;
+
+	// about 3/4 log2(rows), as suggested for M4RI
+	if(k == 0) {
+		for(uint64_t i = dRows; i > 1; i >>= 1)
+			k++;
+		k = (3*k)/4;
+		if(k > MAXBLOCK)
+			k = MAXBLOCK;
+		if(k == 0)
+			k = 1;
+	}
+	m_oTable.Reshape(static_cast<uint64_t>(1) << k, m_oData.GetWords());
+	m_dFirstWord = 0;
+
+	for(uint64_t c = 0; c < vColumns.size() && r < dRows; c += k) {
+		uint32_t dBlock = static_cast<uint32_t>(std::min<uint64_t>(k, vColumns.size()-c));
+		if(bSwapColumns)
+			dBlock = static_cast<uint32_t>(std::min<uint64_t>(dBlock, dRows-c));
+
+		// while all previous columns have a pivot, the pivot rows
+		// of the block are zero in front of the block
+		m_dFirstWord = bPrefix ? c/(sizeof(uint64_t)*8) : 0;
+
+		vBlock.assign(vColumns.begin()+c, vColumns.begin()+c+dBlock);
+		oGather.SetColumns(vBlock);
+		Project(oGather);
+		vPivots.clear();
+
+		for(uint32_t b = 0; b < dBlock && r < dRows; b++) {
+			uint64_t dBit = TOP >> b;
+			uint64_t dPos = r;
+			bool bFound   = false;
+
+			// search the pivot on the projections
+			for(; dPos < dRows; dPos++) {
+				uint64_t dProj = m_vProj[m_vOrder[dPos]];
+				for(uint64_t i = 0; i < vPivots.size(); i++)
+					if(dProj & vPivots[i].dBit)
+						dProj ^= vPivots[i].dProj;
+				if(dProj & dBit) {
+					bFound = true;
+					break;
+				}
+			}
+
+			if(!bFound && bSwapColumns) {
+				dPos = r;
+				ReduceRow(m_vOrder[r], vPivots);
+				uint64_t dColumn = FindColumn(m_vOrder[r], vColumns[c+b]);
+				if(dColumn < m_dColumns) {
+					// the other column may belong to the block as well
+					uint64_t dOther = dColumn < c+dBlock ? TOP >> (dColumn-c) : 0;
+					SwapColumns(vColumns[c+b], dColumn, dBit, dOther);
+					for(uint64_t i = 0; i < vPivots.size(); i++)
+						vPivots[i].dProj = m_vProj[vPivots[i].dRow];
+					bFound = true;
+				}
+			}
+
+			if(!bFound) {
+				// the textbook algorithm keeps the row at this position
+				if(bSwapColumns)
+					r++;
+				bPrefix = false;
+				continue;
+			}
+
+			// make the pivot row zero in the other pivot columns and
+			// the other pivot rows zero in this column
+			uint64_t dRow = m_vOrder[dPos];
+			ReduceRow(dRow, vPivots);
+			for(uint64_t i = 0; i < vPivots.size(); i++) {
+				if(vPivots[i].dProj & dBit) {
+					XorRow(vPivots[i].dRow, dRow);
+					vPivots[i].dProj ^= m_vProj[dRow];
+					m_vProj[vPivots[i].dRow] = vPivots[i].dProj;
+				}
+			}
+			Pivot oPivot = {dRow, m_vProj[dRow], dBit};
+			vPivots.push_back(oPivot);
+
+			if(bStable)
+				std::rotate(m_vOrder.begin()+r, m_vOrder.begin()+dPos, m_vOrder.begin()+dPos+1);
+			else
+				std::swap(m_vOrder[r], m_vOrder[dPos]);
+			r++;
+			dRank++;
+		}
+
+		if(!vPivots.empty())
+			ReduceBlock(vPivots, dBlock);
+	}
+	return dRank;
+}
+
+void
+BlockElimination::ReduceBlock(const std::vector<Pivot> & vPivots, uint32_t dBlockSize) {
+	uint64_t dRows  = m_oData.GetRows();
+	uint64_t dWords = m_oData.GetWords();
+	uint64_t dMask  = 0;
+	uint64_t aRow[MAXBLOCK];
+
+	// columns of the block without a pivot are masked out
+	for(uint32_t b = 0; b < dBlockSize; b++)
+		aRow[b] = dRows;
+	for(uint64_t i = 0; i < vPivots.size(); i++) {
+		aRow[__builtin_clzll(vPivots[i].dBit)] = vPivots[i].dRow;
+		dMask |= vPivots[i].dBit;
+	}
+
+	// Gray code, entry g(i) = g(i-1) + pivot of bit ctz(i)
+	uint64_t dEntries = static_cast<uint64_t>(1) << dBlockSize;
+	uint64_t dPrev    = 0;
+	for(uint64_t i = 1; i < dEntries; i++) {
+		uint64_t dGray = i ^ (i >> 1);
+		uint32_t b     = dBlockSize-1-__builtin_ctzll(i);
+		uint64_t * pDst = m_oTable.Row(dGray);
+		const uint64_t * pPrev = m_oTable.Row(dPrev);
+		if(aRow[b] == dRows)
+			for(uint64_t w = m_dFirstWord; w < dWords; w++)
+				pDst[w] = pPrev[w];
+		else {
+			const uint64_t * pSrc = m_oData.Row(aRow[b]);
+			for(uint64_t w = m_dFirstWord; w < dWords; w++)
+				pDst[w] = pPrev[w] ^ pSrc[w];
+		}
+		dPrev = dGray;
+	}
+
+	for(uint64_t i = 0; i < dRows; i++)
+		m_vIndex[i] = static_cast<uint32_t>((m_vProj[i] & dMask) >> (64-dBlockSize));
+	for(uint64_t i = 0; i < vPivots.size(); i++)
+		m_vIndex[vPivots[i].dRow] = 0;
+
+	// apply the table in stripes such that the used part stays in the cache
+	uint64_t dStripe = STRIPE_BYTES/(dEntries*sizeof(uint64_t));
+	dStripe = std::max<uint64_t>(8, dStripe & ~static_cast<uint64_t>(7));
+	for(uint64_t s = m_dFirstWord; s < dWords; s += dStripe) {
+		uint64_t e = std::min(dWords, s+dStripe);
+		for(uint64_t i = 0; i < dRows; i++) {
+			if(m_vIndex[i] == 0)
+				continue;
+			uint64_t * pDst = m_oData.Row(i);
+			const uint64_t * pSrc = m_oTable.Row(m_vIndex[i]);
+			for(uint64_t w = s; w < e; w++)
+				pDst[w] ^= pSrc[w];
+		}
+	}
+}
+
+void
+BlockElimination::XorRow(uint64_t dDst, uint64_t dSrc) {
+	uint64_t * pDst = m_oData.Row(dDst);
+	const uint64_t * pSrc = m_oData.Row(dSrc);
+	for(uint64_t w = m_dFirstWord; w < m_oData.GetWords(); w++)
+		pDst[w] ^= pSrc[w];
+}
+
+void
+BlockElimination::ReduceRow(uint64_t dRow, const std::vector<Pivot> & vPivots) {
+	for(uint64_t i = 0; i < vPivots.size(); i++) {
+		if(m_vProj[dRow] & vPivots[i].dBit) {
+			XorRow(dRow, vPivots[i].dRow);
+			m_vProj[dRow] ^= vPivots[i].dProj;
+		}
+	}
+}
+
+void
+BlockElimination::Project(const ColumnGather & oGather) {
+	for(uint64_t i = 0; i < m_oData.GetRows(); i++)
+		oGather.Gather(m_oData.Row(i), &m_vProj[i]);
+}
+
+void
+BlockElimination::SwapColumns(uint64_t dCol1, uint64_t dCol2, uint64_t dProj1, uint64_t dProj2) {
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dShift1 = dWordSize-1-dCol1%dWordSize;
+	uint64_t dShift2 = dWordSize-1-dCol2%dWordSize;
+
+	for(uint64_t i = 0; i < m_oData.GetRows(); i++) {
+		uint64_t * pRow = m_oData.Row(i);
+		uint64_t dBit1 = (pRow[dCol1/dWordSize] >> dShift1) & 1;
+		uint64_t dBit2 = (pRow[dCol2/dWordSize] >> dShift2) & 1;
+		if(dBit1 != dBit2) {
+			pRow[dCol1/dWordSize] ^= static_cast<uint64_t>(1) << dShift1;
+			pRow[dCol2/dWordSize] ^= static_cast<uint64_t>(1) << dShift2;
+			m_vProj[i] ^= dProj1 | dProj2;
+		}
+	}
+	std::swap(m_vColsPerm[dCol1], m_vColsPerm[dCol2]);
+}
+
+uint64_t
+BlockElimination::FindColumn(uint64_t dRow, uint64_t dFrom) {
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	const uint64_t * pRow = m_oData.Row(dRow);
+
+	if(dFrom >= m_dColumns)
+		return m_dColumns;
+	// the unused bits of the last word are zero
+	uint64_t dWord = pRow[dFrom/dWordSize] & (~static_cast<uint64_t>(0) >> (dFrom%dWordSize));
+	for(uint64_t w = dFrom/dWordSize; ; ) {
+		if(dWord != 0)
+			return w*dWordSize + __builtin_clzll(dWord);
+		if(++w >= m_dWords)
+			return m_dColumns;
+		dWord = pRow[w];
+	}
+}
+
+void
+BlockElimination::Store(CodeMatrix & oMatrix, uint64_t dFirst, uint64_t dWord, uint64_t dColumns) {
+	uint64_t dRows  = m_vOrder.size()-std::min<uint64_t>(dFirst, m_vOrder.size());
+	uint64_t dWords = (dColumns+sizeof(uint64_t)*8-1)/(sizeof(uint64_t)*8);
+
+	oMatrix.Allocate(dRows, dColumns);
+	for(uint64_t i = 0; i < dRows; i++) {
+		uint64_t * pRow = oMatrix.m_oStorage.Row(i);
+		memcpy(pRow, m_oData.Row(m_vOrder[dFirst+i])+dWord, dWords*sizeof(uint64_t));
+		oMatrix.m_oData[i].Bind(pRow, dColumns, RowWeight(pRow, dWords));
+	}
+}
+
+void
+BlockElimination::GetRows(CodeMatrix & oMatrix, uint64_t dFirst) {
+	Store(oMatrix, dFirst, 0, m_dColumns);
+}
+
+void
+BlockElimination::GetRows(CodeMatrix & oMatrix, uint64_t dFirst, const std::vector<uint64_t> & vColumns) {
+	uint64_t dRows = m_vOrder.size()-std::min<uint64_t>(dFirst, m_vOrder.size());
+	ColumnGather oGather(vColumns);
+
+	oMatrix.Allocate(dRows, vColumns.size());
+	for(uint64_t i = 0; i < dRows; i++) {
+		uint64_t * pRow = oMatrix.m_oStorage.Row(i);
+		oMatrix.m_oData[i].Bind(pRow, vColumns.size(), oGather.Gather(m_oData.Row(m_vOrder[dFirst+i]), pRow));
+	}
+}
+
+void
+BlockElimination::GetAttached(CodeMatrix & oMatrix) {
+	Store(oMatrix, 0, m_dWords, m_dAttached);
+}
+
+const std::vector<uint64_t> &
+BlockElimination::GetColumnPermutation() const {
+	return m_vColsPerm;
+}
+
+//EOF
@@ -0,0 +1,58 @@
+/*!
+  \file CanteautChabaudEngine.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class CanteautChabaudEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CanteautChabaudEngine.h"
+
+CanteautChabaudEngine::CanteautChabaudEngine(void) {
+}
+
+CanteautChabaudEngine::~CanteautChabaudEngine(void) {
+}
+
+IsdEngine *
+CanteautChabaudEngine::Clone() const {
+	return new CanteautChabaudEngine(*this);
+}
+
+const char *
+CanteautChabaudEngine::GetName() const {
+	return "cc";
+}
+
+void
+CanteautChabaudEngine::Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback) {
+	uint64_t dHalf = oZ.GetRows()/2;
+
+	Project(oZ, m_dSigma, oRnGen);
+
+	m_oList1.Clear();
+	m_oList2.Clear();
+	Enumerate(0, dHalf, 1, m_dP, m_oList1);
+	Enumerate(dHalf, 2*dHalf, 1, m_dP, m_oList2);
+
+	// as in the original algorithm, a combination of Z2 is only
+	// combined with the last combination of Z1 with the same key
+	Collide(m_oList1, m_oList2, oCallback, true);
+}
+
+//EOF
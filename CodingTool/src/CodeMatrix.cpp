@@ -21,10 +21,24 @@
 // You should have received a copy of the GNU General Public License
 // along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+
 #include "CodeMatrix.h"
 
+//! Magic at the start of a binary matrix file.
+static const char BINARYMAGIC[8] = {'C','T','M','A','T','R','I','X'};
+//! Written as 64-bit word to detect files of a different byte order.
+static const uint64_t BYTEORDER = 0x0102030405060708ULL;
+
+CodeMatrix::CodeMatrix(void) : m_dColumns(0) {
+}
+
+CodeMatrix::CodeMatrix(const CodeMatrix & oM) : m_dColumns(0) {
+	*this = oM;
+}
 
-CodeMatrix::CodeMatrix(void) {
+CodeMatrix::CodeMatrix(CodeMatrix && oM) noexcept : m_dColumns(0) {
+	Swap(oM);
 }
 
 CodeMatrix::~CodeMatrix(void) {
@@ -32,35 +46,177 @@ CodeMatrix::~CodeMatrix(void) {
 
 void
 CodeMatrix::Build(CodeWord (*pBuildFunction)(uint64_t&), uint64_t dDim) {
+	m_oStorage.Clear();
 	m_oData.clear();
-	for(uint64_t i = 0; i < dDim; i++)
+	m_dColumns = 0;
+	for(uint64_t i = 0; i < dDim; i++) {
 		this->AddRow(pBuildFunction(i));
+		// the length is known after the first row
+		if(i == 0) {
+			m_oData.reserve(dDim);
+			m_oStorage.Reserve(dDim);
+			RebindRows();
+		}
+	}
 }
 
 void
-CodeMatrix::AddRow(CodeWord oRow) {
-	if(!m_oData.empty())
+CodeMatrix::AddRow(const CodeWord & oRow) {
+	if(!m_oData.empty()) {
 		if(m_oData[0].GetLength() != oRow.GetLength()) {
 			std::cout << "Error: Adding code word to matrix with wrong length" << std::endl;
 			return;
 		}
-	m_oData.push_back(oRow);
+	}
+	else
+		Allocate(0, oRow.GetLength());
+
+	// a row of this matrix is freed if the storage grows, e.g. M.AddRow(M[0])
+	if(oRow.m_dLength64 > 0 && m_oStorage.GetRows() > 0 &&
+	   oRow.m_pData >= m_oStorage.Row(0) && oRow.m_pData < m_oStorage.Row(m_oStorage.GetRows())) {
+		CodeWord oCopy(oRow);
+		AddRow(oCopy);
+		return;
+	}
+
+	uint64_t dRow = m_oData.size();
+
+	// the moved views point to the old storage until they are rebound
+	bool bMoved = m_oData.size() == m_oData.capacity();
+	m_oData.push_back(CodeWord());
+	bMoved |= m_oStorage.AddRow();
+
+	memcpy(m_oStorage.Row(dRow), oRow.m_pData, oRow.m_dLength64*sizeof(uint64_t));
+	m_oData[dRow].Bind(m_oStorage.Row(dRow), m_dColumns, oRow.GetHammingWeight());
+
+	if(bMoved)
+		RebindRows();
+}
+
+void
+CodeMatrix::Reserve(uint64_t dRows) {
+	assert(!m_oStorage.IsView());
+	bool bMoved = dRows > m_oData.capacity();
+	m_oData.reserve(dRows);
+	bMoved |= m_oStorage.Reserve(dRows);
+	if(bMoved)
+		RebindRows();
+}
+
+void
+CodeMatrix::Resize(uint64_t dRows, uint64_t dColumns) {
+	if(dColumns != m_dColumns || m_oData.empty() || m_oStorage.IsView()) {
+		Allocate(dRows, dColumns);
+		return;
+	}
+
+	uint64_t dOld = m_oData.size();
+	bool bMoved = dRows > m_oData.capacity();
+	m_oData.resize(dRows);
+	bMoved |= m_oStorage.Resize(dRows);
+	RebindRows(bMoved ? 0 : std::min(dOld, dRows));
 }
 
 CodeMatrix
-CodeMatrix::GetSubMatrix(std::vector<uint64_t> & vRows, std::vector<uint64_t> & vCols) {
+CodeMatrix::GetSubMatrix(const std::vector<uint64_t> & vRows, const std::vector<uint64_t> & vCols) const {
 
-	CodeWord oTempWord;
 	CodeMatrix oSubMatrix;
+	GetSubMatrix(vRows, ColumnGather(vCols), oSubMatrix);
+	return oSubMatrix;
+}
+
+void
+CodeMatrix::GetSubMatrix(const std::vector<uint64_t> & vRows, const ColumnGather & oGather, CodeMatrix & oSubMatrix) const {
+	assert(this != &oSubMatrix);
 
 	// copy specified rows and columns
+	oSubMatrix.Allocate(vRows.size(), oGather.GetColumns());
 	for(uint64_t i = 0; i < vRows.size(); i++) {
-		for(uint64_t j = 0; j < vCols.size(); j++)
-			oTempWord.PushBool(m_oData[vRows[i]].AtBool(vCols[j]));
-		oSubMatrix.AddRow(oTempWord);
-		oTempWord.Clear();
+		assert(vRows[i] < m_oData.size());
+		uint64_t * pRow = oSubMatrix.m_oStorage.Row(i);
+		oSubMatrix.m_oData[i].Bind(pRow, oGather.GetColumns(), oGather.Gather(m_oStorage.Row(vRows[i]), pRow));
+	}
+}
+
+void
+CodeMatrix::GetRowRange(uint64_t dFirst, uint64_t dRows, CodeMatrix & oView) {
+	assert(dFirst+dRows <= m_oData.size() && this != &oView);
+
+	oView.m_dColumns = m_dColumns;
+	oView.m_oStorage.Attach(m_oStorage.Row(dFirst), dRows, m_oStorage.GetWords(), m_oStorage.GetStride());
+	oView.m_oData.clear();
+	oView.m_oData.resize(dRows);
+	for(uint64_t i = 0; i < dRows; i++)
+		oView.m_oData[i].Bind(oView.m_oStorage.Row(i), m_dColumns, m_oData[dFirst+i].GetHammingWeight());
+}
+
+uint64_t
+CodeMatrix::XorWeight(const uint64_t * pRows, uint32_t dRows, uint64_t dBound) const {
+	const uint64_t * apRows[MAXXORROWS];
+
+	assert(dRows > 0 && dRows <= MAXXORROWS);
+	for(uint32_t i = 0; i < dRows; i++) {
+		assert(pRows[i] < m_oData.size());
+		apRows[i] = m_oStorage.Row(pRows[i]);
+	}
+	return RowsXorWeight(apRows, dRows, m_oStorage.GetWords(), dBound);
+}
+
+uint64_t
+CodeMatrix::XorWeight(const uint64_t * pRows, uint32_t dRows, const WeightTable & oWeights,
+                      uint64_t dBound) const {
+	const uint64_t * apRows[MAXXORROWS];
+	uint64_t dWords  = m_oStorage.GetWords();
+	uint64_t dWeight = 0;
+
+	assert(dRows > 0 && dRows <= MAXXORROWS && oWeights.GetWords() >= dWords);
+	for(uint32_t i = 0; i < dRows; i++) {
+		assert(pRows[i] < m_oData.size());
+		apRows[i] = m_oStorage.Row(pRows[i]);
+	}
+
+	for(uint64_t i = 0; i < dWords; i += ROWCHUNK) {
+		uint64_t dEnd = i+ROWCHUNK < dWords ? i+ROWCHUNK : dWords;
+		for(uint64_t j = i; j < dEnd; j++) {
+			uint64_t dData = apRows[0][j];
+			for(uint32_t k = 1; k < dRows; k++)
+				dData ^= apRows[k][j];
+			dWeight += oWeights.Weight(dData, j);
+		}
+		if(dWeight >= dBound)
+			break;
+	}
+	return dWeight;
+}
+
+void
+CodeMatrix::Pivot(uint64_t dRow, uint64_t dColumn, std::vector<uint64_t> & vColumn) {
+	uint64_t dRows  = m_oData.size();
+	uint64_t dWords = m_oStorage.GetWords();
+	uint64_t dWord  = dColumn/64;
+	uint64_t dBit   = static_cast<uint64_t>(1) << (63-dColumn%64);
+
+	assert(dRow < dRows && dColumn < m_dColumns && (m_oStorage.Row(dRow)[dWord] & dBit) != 0);
+
+	// the column is read with one load per row
+	vColumn.assign((dRows+63)/64, 0);
+	for(uint64_t i = 0; i < dRows; i++)
+		vColumn[i/64] |= static_cast<uint64_t>((m_oStorage.Row(i)[dWord] & dBit) != 0) << (i%64);
+	vColumn[dRow/64] &= ~(static_cast<uint64_t>(1) << (dRow%64));
+
+	const uint64_t * pPivot = m_oStorage.Row(dRow);
+
+	for(uint64_t w = 0; w < vColumn.size(); w++) {
+		for(uint64_t dMask = vColumn[w]; dMask != 0; dMask &= dMask-1) {
+			uint64_t   i    = w*64+__builtin_ctzll(dMask);
+			uint64_t * pDst = m_oStorage.Row(i);
+
+			// the xor clears the pivot bit, it is set again
+			uint64_t dWeight = RowXorWeight(pDst, pPivot, dWords);
+			pDst[dWord] |= dBit;
+			m_oData[i].m_dHammingWeight = dWeight+1;
+		}
 	}
-	return oSubMatrix;
 }
 
 bool
@@ -96,14 +252,80 @@ CodeMatrix::Set64(uint64_t dRow, uint64_t dCol, uint64_t dData) {
 void
 CodeMatrix::DeleteRow(uint64_t dRow) {
 	assert(dRow < m_oData.size());
-	m_oData.erase(m_oData.begin()+dRow);
+	m_oStorage.DeleteRow(dRow);
+	// the views keep their position, only the weights move
+	for(uint64_t i = dRow; i+1 < m_oData.size(); i++)
+		m_oData[i].m_dHammingWeight = m_oData[i+1].m_dHammingWeight;
+	m_oData.pop_back();
+}
+
+void
+CodeMatrix::SwapRows(uint64_t dRow1, uint64_t dRow2) {
+	assert(dRow1 < m_oData.size() && dRow2 < m_oData.size());
+	m_oStorage.SwapRows(dRow1, dRow2);
+	std::swap(m_oData[dRow1].m_dHammingWeight, m_oData[dRow2].m_dHammingWeight);
+}
+
+void
+CodeMatrix::Swap(CodeMatrix & oM) noexcept {
+	// the views point into the memory of the storage, which is not moved
+	m_oStorage.Swap(oM.m_oStorage);
+	m_oData.swap(oM.m_oData);
+	std::swap(m_dColumns, oM.m_dColumns);
 }
 
 void
 CodeMatrix::DeleteColumn(uint64_t dColumn) {
-	assert(dColumn < m_oData[0].GetLength());
-	for(uint32_t i = 0; i < m_oData.size(); i++)
+	assert(dColumn < m_dColumns);
+	for(uint64_t i = 0; i < m_oData.size(); i++)
 		m_oData[i].EraseBool(dColumn);
+	m_dColumns--;
+	m_oStorage.SetWords((m_dColumns+sizeof(uint64_t)*8-1)/(sizeof(uint64_t)*8));
+}
+
+void
+CodeMatrix::PermuteColumns(const std::vector<uint64_t> & vPerm) {
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dWords    = GetColumns64();
+	std::vector<uint64_t> vColumns(dWords*dWordSize);
+	uint64_t aBlock[64];
+
+	assert(vPerm.size() == m_dColumns);
+
+	for(uint64_t r = 0; r < m_oData.size(); r += dWordSize) {
+		uint64_t dRows = std::min<uint64_t>(dWordSize, m_oData.size()-r);
+
+		// the columns of the block, bit 63-i of a column is row r+i
+		for(uint64_t w = 0; w < dWords; w++) {
+			for(uint64_t i = 0; i < dWordSize; i++)
+				aBlock[i] = i < dRows ? m_oStorage.Row(r+i)[w] : 0;
+			Transpose64(aBlock);
+			for(uint64_t j = 0; j < dWordSize; j++)
+				vColumns[w*dWordSize+j] = aBlock[j];
+		}
+
+		// the permuted columns back to the rows, unused bits stay zero
+		for(uint64_t w = 0; w < dWords; w++) {
+			for(uint64_t j = 0; j < dWordSize; j++)
+				aBlock[j] = w*dWordSize+j < m_dColumns ? vColumns[vPerm[w*dWordSize+j]] : 0;
+			Transpose64(aBlock);
+			for(uint64_t i = 0; i < dRows; i++)
+				m_oStorage.Row(r+i)[w] = aBlock[i];
+		}
+	}
+}
+
+void
+CodeMatrix::Transpose64(uint64_t * pBlock) {
+	uint64_t dMask = 0x00000000FFFFFFFFULL;
+
+	// swaps the off-diagonal blocks of size 32, 16, ..., 1
+	for(uint32_t j = 32; j != 0; j >>= 1, dMask ^= dMask << j)
+		for(uint32_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+			uint64_t dTemp = (pBlock[k] ^ (pBlock[k | j] >> j)) & dMask;
+			pBlock[k]     ^= dTemp;
+			pBlock[k | j] ^= dTemp << j;
+		}
 }
 
 uint64_t
@@ -114,7 +336,7 @@ CodeMatrix::GetRows() const {
 uint64_t
 CodeMatrix::GetColumns() const {
 	if(m_oData.size() > 0)
-		return m_oData[0].GetLength();
+		return m_dColumns;
 	else
 		return 0;
 }
@@ -122,7 +344,7 @@ CodeMatrix::GetColumns() const {
 uint64_t
 CodeMatrix::GetColumns64() const {
 	if(m_oData.size() > 0)
-		return m_oData[0].GetLength64();
+		return m_oStorage.GetWords();
 	else
 		return 0;
 }
@@ -154,6 +376,11 @@ CodeMatrix::PrintMatrix(const std::string & sFileName) {
 void
 CodeMatrix::ReadFromFile(const std::string & sFileName) {
 
+	if(IsBinaryFile(sFileName)) {
+		ReadBinaryFile(sFileName);
+		return;
+	}
+
 	std::fstream oFileStream;
 
 	oFileStream.open(sFileName.c_str(), std::ios::in);
@@ -176,7 +403,7 @@ CodeMatrix::ReadFromFile(const std::string & sFileName) {
 				sStream >> dValue;
 				oCodeWord.PushBool(static_cast<bool>(dValue));
 			}
-			m_oData.push_back(oCodeWord);
+			AddRow(oCodeWord);
 			oCodeWord.Clear();
 			sStream.clear();
 		}
@@ -185,6 +412,152 @@ CodeMatrix::ReadFromFile(const std::string & sFileName) {
 	oFileStream.close();
 }
 
+bool
+CodeMatrix::WriteBinaryFile(const std::string & sFileName) {
+	std::ofstream oFile(sFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if(oFile.fail() || !WriteBinary(oFile)) {
+		std::cout << "Error: The file " << sFileName << " can not be written." << std::endl;
+		return false;
+	}
+
+	oFile.close();
+	if(oFile.fail()) {
+		std::cout << "Error: The file " << sFileName << " can not be written." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool
+CodeMatrix::WriteBinary(std::ostream & oStream) {
+	BinaryHeader oHeader;
+	memset(&oHeader, 0, sizeof(oHeader));
+	memcpy(oHeader.aMagic, BINARYMAGIC, sizeof(oHeader.aMagic));
+	oHeader.dVersion    = BINARYVERSION;
+	oHeader.dHeaderSize = BINARYHEADER;
+	oHeader.dRows       = m_oData.size();
+	oHeader.dColumns    = m_dColumns;
+	oHeader.dStride     = m_oStorage.GetStride();
+	oHeader.dByteOrder  = BYTEORDER;
+	oStream.write(reinterpret_cast<const char*>(&oHeader), sizeof(oHeader));
+
+	// the rows including the padding words, such that they can be mapped
+	if(oHeader.dRows*oHeader.dStride > 0)
+		oStream.write(reinterpret_cast<const char*>(m_oStorage.Row(0)),
+		              oHeader.dRows*oHeader.dStride*sizeof(uint64_t));
+
+	for(uint64_t i = 0; i < m_oData.size(); i++) {
+		uint64_t dWeight = m_oData[i].GetHammingWeight();
+		oStream.write(reinterpret_cast<const char*>(&dWeight), sizeof(dWeight));
+	}
+	return !oStream.fail();
+}
+
+bool
+CodeMatrix::ReadBinaryFile(const std::string & sFileName) {
+	std::ifstream oFile(sFileName.c_str(), std::ios::in | std::ios::binary);
+	if(oFile.fail()) {
+		std::cout << "Error: The file " << sFileName << " does not exist." << std::endl;
+		return false;
+	}
+
+	BinaryHeader oHeader;
+	oFile.read(reinterpret_cast<char*>(&oHeader), sizeof(oHeader));
+	if(oFile.gcount() != sizeof(oHeader) || memcmp(oHeader.aMagic, BINARYMAGIC, sizeof(oHeader.aMagic)) != 0) {
+		std::cout << "Error: The file " << sFileName << " is not a binary matrix." << std::endl;
+		return false;
+	}
+	if(oHeader.dVersion != BINARYVERSION || oHeader.dByteOrder != BYTEORDER) {
+		std::cout << "Error: The binary matrix " << sFileName << " has an unsupported version or byte order." << std::endl;
+		return false;
+	}
+
+	uint64_t dWords = (oHeader.dColumns+sizeof(uint64_t)*8-1)/(sizeof(uint64_t)*8);
+	uint64_t dData  = oHeader.dRows*oHeader.dStride*sizeof(uint64_t);
+	oFile.seekg(0, std::ios::end);
+	uint64_t dSize = oFile.tellg();
+	if(oHeader.dHeaderSize < sizeof(oHeader) || oHeader.dHeaderSize%sizeof(uint64_t) != 0 ||
+	   oHeader.dStride < dWords || (oHeader.dRows > 0 && oHeader.dStride == 0) ||
+	   dSize < oHeader.dHeaderSize+dData+oHeader.dRows*sizeof(uint64_t)) {
+		std::cout << "Error: The binary matrix " << sFileName << " is corrupt." << std::endl;
+		return false;
+	}
+
+	m_oData.clear();
+	m_dColumns = 0;
+	std::vector<uint64_t> vWeights(oHeader.dRows);
+
+	const char * pFile = NULL;
+	if(oHeader.dRows > 0)
+		pFile = m_oStorage.MapFile(sFileName, oHeader.dHeaderSize, oHeader.dRows, dWords, oHeader.dStride);
+
+	if(pFile == NULL) {
+		// no memory mapping, read the rows with the stride of the storage
+		oFile.seekg(0, std::ios::beg);
+		if(!ReadBinary(oFile)) {
+			std::cout << "Error: The binary matrix " << sFileName << " can not be read." << std::endl;
+			return false;
+		}
+		return true;
+	}
+	memcpy(&vWeights[0], pFile+oHeader.dHeaderSize+dData, oHeader.dRows*sizeof(uint64_t));
+	oFile.close();
+
+	m_dColumns = oHeader.dColumns;
+	m_oData.resize(oHeader.dRows);
+	for(uint64_t i = 0; i < m_oData.size(); i++)
+		m_oData[i].Bind(m_oStorage.Row(i), m_dColumns, vWeights[i]);
+	return true;
+}
+
+bool
+CodeMatrix::ReadBinary(std::istream & oStream) {
+	BinaryHeader oHeader;
+
+	m_oData.clear();
+	m_dColumns = 0;
+	m_oStorage.Clear();
+
+	oStream.read(reinterpret_cast<char*>(&oHeader), sizeof(oHeader));
+	if(oStream.fail() || memcmp(oHeader.aMagic, BINARYMAGIC, sizeof(oHeader.aMagic)) != 0 ||
+	   oHeader.dVersion != BINARYVERSION || oHeader.dByteOrder != BYTEORDER)
+		return false;
+
+	uint64_t dWords = (oHeader.dColumns+sizeof(uint64_t)*8-1)/(sizeof(uint64_t)*8);
+	if(oHeader.dHeaderSize < sizeof(oHeader) || oHeader.dHeaderSize%sizeof(uint64_t) != 0 ||
+	   oHeader.dStride < dWords || (oHeader.dRows > 0 && oHeader.dStride == 0))
+		return false;
+	oStream.ignore(oHeader.dHeaderSize-sizeof(oHeader));
+
+	std::vector<uint64_t> vWeights(oHeader.dRows);
+	std::vector<uint64_t> vRow(oHeader.dStride);
+	m_oStorage.Reshape(oHeader.dRows, dWords);
+	for(uint64_t i = 0; i < oHeader.dRows && !oStream.fail(); i++) {
+		oStream.read(reinterpret_cast<char*>(&vRow[0]), oHeader.dStride*sizeof(uint64_t));
+		memcpy(m_oStorage.Row(i), &vRow[0], dWords*sizeof(uint64_t));
+	}
+	if(oHeader.dRows > 0)
+		oStream.read(reinterpret_cast<char*>(&vWeights[0]), oHeader.dRows*sizeof(uint64_t));
+	if(oStream.fail()) {
+		m_oStorage.Clear();
+		return false;
+	}
+
+	m_dColumns = oHeader.dColumns;
+	m_oData.resize(oHeader.dRows);
+	for(uint64_t i = 0; i < m_oData.size(); i++)
+		m_oData[i].Bind(m_oStorage.Row(i), m_dColumns, vWeights[i]);
+	return true;
+}
+
+bool
+CodeMatrix::IsBinaryFile(const std::string & sFileName) {
+	std::ifstream oFile(sFileName.c_str(), std::ios::in | std::ios::binary);
+	char aMagic[8];
+	oFile.read(aMagic, sizeof(aMagic));
+	return oFile.gcount() == sizeof(aMagic) && memcmp(aMagic, BINARYMAGIC, sizeof(aMagic)) == 0;
+}
+
 bool
 CodeMatrix::IsSystematic() {
 
@@ -205,21 +578,54 @@ CodeMatrix::IsSystematic() {
 CodeMatrix
 CodeMatrix::Transpose() {
 
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dWords    = GetColumns64();
+	uint64_t aBlock[64];
 	CodeMatrix oReturn;
-	for(uint64_t i = 0; i < GetColumns(); i++) {
-		CodeWord oTempWord;
-		oReturn.AddRow(oTempWord);
+
+	oReturn.Allocate(GetColumns(), GetRows());
+	for(uint64_t r = 0; r < m_oData.size(); r += dWordSize) {
+		uint64_t dRows = std::min<uint64_t>(dWordSize, m_oData.size()-r);
+
+		// bit 63-i of column w*64+j is row r+i, i.e. word r/64 of the transposed row
+		for(uint64_t w = 0; w < dWords; w++) {
+			for(uint64_t i = 0; i < dWordSize; i++)
+				aBlock[i] = i < dRows ? m_oStorage.Row(r+i)[w] : 0;
+			Transpose64(aBlock);
+			for(uint64_t j = 0; j < dWordSize && w*dWordSize+j < m_dColumns; j++)
+				oReturn.m_oStorage.Row(w*dWordSize+j)[r/dWordSize] = aBlock[j];
+		}
 	}
-	for(uint64_t i = 0; i < GetRows(); i++)
-		for(uint64_t j = 0; j < GetColumns(); j++)
-			oReturn[j].SetBool(i,m_oData[i].AtBool(j));
+	for(uint64_t i = 0; i < oReturn.GetRows(); i++)
+		oReturn.m_oData[i].Bind(oReturn.m_oStorage.Row(i), oReturn.m_dColumns,
+		                        RowWeight(oReturn.m_oStorage.Row(i), oReturn.m_oStorage.GetWords()));
 	return oReturn;
 
 }
 
 CodeMatrix &
 CodeMatrix::operator=(const CodeMatrix& oLeftSide) {
-	m_oData = oLeftSide.m_oData;
+	if(this == &oLeftSide)
+		return *this;
+
+	m_oStorage = oLeftSide.m_oStorage;
+	m_dColumns = oLeftSide.m_dColumns;
+	m_oData.clear();
+	m_oData.resize(oLeftSide.m_oData.size());
+	for(uint64_t i = 0; i < m_oData.size(); i++)
+		m_oData[i].Bind(m_oStorage.Row(i), m_dColumns, oLeftSide.m_oData[i].GetHammingWeight());
+	return *this;
+}
+
+CodeMatrix &
+CodeMatrix::operator=(CodeMatrix && oM) noexcept {
+	if(this == &oM)
+		return *this;
+
+	Swap(oM);
+	oM.m_oStorage.Clear();
+	oM.m_oData.clear();
+	oM.m_dColumns = 0;
 	return *this;
 }
 
@@ -229,4 +635,19 @@ CodeMatrix::operator[](uint64_t dIndex) {
 	return m_oData[dIndex];
 }
 
+void
+CodeMatrix::Allocate(uint64_t dRows, uint64_t dColumns) {
+	m_dColumns = dColumns;
+	m_oStorage.Reshape(dRows, (dColumns+sizeof(uint64_t)*8-1)/(sizeof(uint64_t)*8));
+	m_oData.clear();
+	m_oData.resize(dRows);
+	RebindRows();
+}
+
+void
+CodeMatrix::RebindRows(uint64_t dFirst) {
+	for(uint64_t i = dFirst; i < m_oData.size(); i++)
+		m_oData[i].Bind(m_oStorage.Row(i), m_dColumns, m_oData[i].GetHammingWeight());
+}
+
 //EOF
@@ -21,10 +21,35 @@
 // You should have received a copy of the GNU General Public License
 // along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+
 #include "CodeWord.h"
 
-CodeWord::CodeWord(void) : m_dHammingWeight(0),m_dOffSet(0) {
+CodeWord::CodeWord(void)
+  : m_dHammingWeight(0), m_pData(NULL), m_dLength64(0), m_dOffSet(0), m_bView(false) {
+
+}
+
+CodeWord::CodeWord(const CodeWord & oCodeWord)
+  : m_dHammingWeight(oCodeWord.m_dHammingWeight),
+    m_oData(oCodeWord.m_pData, oCodeWord.m_pData+oCodeWord.m_dLength64),
+    m_pData(NULL), m_dLength64(0), m_dOffSet(oCodeWord.m_dOffSet), m_bView(false) {
+	Sync();
+}
 
+CodeWord::CodeWord(CodeWord && oCodeWord) noexcept
+  : m_dHammingWeight(oCodeWord.m_dHammingWeight),
+    m_pData(NULL), m_dLength64(0), m_dOffSet(oCodeWord.m_dOffSet), m_bView(false) {
+	// a moved view refers to the same data, e.g. if the rows of a CodeMatrix grow
+	if(oCodeWord.m_bView) {
+		m_bView     = true;
+		m_pData     = oCodeWord.m_pData;
+		m_dLength64 = oCodeWord.m_dLength64;
+		return;
+	}
+	m_oData.swap(oCodeWord.m_oData);
+	oCodeWord.Clear();
+	Sync();
 }
 
 CodeWord::~CodeWord(void) {
@@ -39,32 +64,30 @@ CodeWord::GetHammingWeight() const {
 uint64_t
 CodeWord::GetHammingWeight(std::vector<uint64_t> & vWeights) const {
 	uint64_t dWeight = 0;
-	uint16_t dWordSize = sizeof(uint64_t)*8;
 
-	for(uint64_t i = 0; i < m_oData.size(); i++)
-		for(uint64_t j = 0; j < dWordSize; j++) {
-			if( (m_oData[i] >> ((dWordSize-1)-j)) & 1 )
-				dWeight += vWeights[i];
-		}
+	// bit 63-j of word i is bit 64*i+j of the code word
+	for(uint64_t i = 0; i < m_dLength64; i++)
+		for(uint64_t dData = m_pData[i]; dData != 0; dData &= dData-1)
+			dWeight += vWeights[64*i+63-__builtin_ctzll(dData)];
 	return dWeight;
 }
 
 uint64_t 
 CodeWord::GetLength() const {
-	return static_cast<uint64_t>(m_oData.size()*sizeof(uint64_t)*8-m_dOffSet);
+	return static_cast<uint64_t>(m_dLength64*sizeof(uint64_t)*8-m_dOffSet);
 }
 
 uint64_t 
 CodeWord::GetLength64() const {
-	return m_oData.size();
+	return m_dLength64;
 }
 
 std::vector<bool> 
 CodeWord::GetDataBool() const {
 	std::vector<bool> vReturn;
-	for(uint32_t i = 0; i < m_oData.size(); i++)
+	for(uint32_t i = 0; i < m_dLength64; i++)
 		for(uint32_t j = 0; j < sizeof(uint64_t)*8; j++)
-			vReturn.push_back((m_oData[i] >> ((sizeof(uint64_t)*8-1)-j)) & 1);
+			vReturn.push_back((m_pData[i] >> ((sizeof(uint64_t)*8-1)-j)) & 1);
 	return vReturn;
 }
 
@@ -72,12 +95,12 @@ std::vector<uint32_t>
 CodeWord::GetDataUInt32() const {
 	std::vector<uint32_t> vReturn;
 	if(sizeof(uint64_t)==4)
-		for(uint32_t i = 0; i < m_oData.size(); i++)
-			vReturn.push_back(static_cast<uint32_t>(m_oData[i]));
+		for(uint32_t i = 0; i < m_dLength64; i++)
+			vReturn.push_back(static_cast<uint32_t>(m_pData[i]));
 	else {
-		for(uint32_t i = 0; i < m_oData.size(); i++){
-			vReturn.push_back(static_cast<uint32_t>(m_oData[i] >> (sizeof(uint32_t)*8)));
-			vReturn.push_back(static_cast<uint32_t>(m_oData[i]));
+		for(uint32_t i = 0; i < m_dLength64; i++){
+			vReturn.push_back(static_cast<uint32_t>(m_pData[i] >> (sizeof(uint32_t)*8)));
+			vReturn.push_back(static_cast<uint32_t>(m_pData[i]));
 		}
 	}
 	return vReturn;
@@ -85,32 +108,32 @@ CodeWord::GetDataUInt32() const {
 
 std::vector<uint64_t>
 CodeWord::GetDataUInt64() const {
-	return m_oData;
+	return std::vector<uint64_t>(m_pData, m_pData+m_dLength64);
 }
 
 bool
 CodeWord::AtBool(uint64_t dIndex) const {
-	assert(sizeof(uint64_t)*8*m_oData.size() > dIndex);
+	assert(sizeof(uint64_t)*8*m_dLength64 > dIndex);
 	uint64_t dWordSize = sizeof(uint64_t)*8;
-	bool bReturn = (m_oData[dIndex/dWordSize] >> (dWordSize-1-dIndex%dWordSize)) & 1;
+	bool bReturn = (m_pData[dIndex/dWordSize] >> (dWordSize-1-dIndex%dWordSize)) & 1;
 	return bReturn;
 }
 uint32_t
 CodeWord::At32(uint64_t dIndex) const {
-	assert(sizeof(uint64_t)/sizeof(uint32_t)*m_oData.size() > dIndex);
+	assert(sizeof(uint64_t)/sizeof(uint32_t)*m_dLength64 > dIndex);
 
 	uint32_t dReturn;
 
 	if(sizeof(uint64_t)==4)
-		return static_cast<uint32_t>(m_oData[dIndex]);
+		return static_cast<uint32_t>(m_pData[dIndex]);
 	else {
 		if(dIndex%(sizeof(uint64_t)/sizeof(uint32_t)))
-			dReturn = static_cast<uint32_t>(m_oData[dIndex/(sizeof(uint64_t)/sizeof(uint32_t))]);
+			dReturn = static_cast<uint32_t>(m_pData[dIndex/(sizeof(uint64_t)/sizeof(uint32_t))]);
 		else
-			dReturn = static_cast<uint32_t>(m_oData[dIndex/(sizeof(uint64_t)/sizeof(uint32_t))] >> sizeof(uint32_t)*8);
+			dReturn = static_cast<uint32_t>(m_pData[dIndex/(sizeof(uint64_t)/sizeof(uint32_t))] >> sizeof(uint32_t)*8);
 	}
 	// if we are at the last word and there is a offset, remove the offset
-	if( m_oData.size() == dIndex/sizeof(uint64_t) +1) {
+	if( m_dLength64 == dIndex/sizeof(uint64_t) +1) {
 		if(dIndex%(sizeof(uint64_t)/sizeof(uint32_t)))
 			dReturn >>= m_dOffSet;
 		else
@@ -121,24 +144,24 @@ CodeWord::At32(uint64_t dIndex) const {
 }
 uint64_t
 CodeWord::At64(uint64_t dIndex) const {
-	if( m_oData.size() == dIndex+1)
-		return m_oData[dIndex] >> m_dOffSet;
-	return m_oData[dIndex];
+	if( m_dLength64 == dIndex+1)
+		return m_pData[dIndex] >> m_dOffSet;
+	return m_pData[dIndex];
 }
 
 void
 CodeWord::SetBool(uint64_t dIndex, bool dData) {
 	uint32_t dWordSize = sizeof(uint64_t)*8;
 	
-	m_dHammingWeight -= HammingWeight(m_oData[dIndex/dWordSize]);
+	m_dHammingWeight -= HammingWeight(m_pData[dIndex/dWordSize]);
 
 	uint64_t dMask = static_cast<uint64_t>(1) << (dWordSize-1-dIndex%dWordSize); ;
 	if(dData)
-		m_oData[dIndex/dWordSize] |= dMask;
+		m_pData[dIndex/dWordSize] |= dMask;
 	else
-		m_oData[dIndex/dWordSize] &= ~dMask;
+		m_pData[dIndex/dWordSize] &= ~dMask;
 
-	m_dHammingWeight += HammingWeight(m_oData[dIndex/dWordSize]);
+	m_dHammingWeight += HammingWeight(m_pData[dIndex/dWordSize]);
 }
 
 void
@@ -146,56 +169,61 @@ CodeWord::Set32(uint64_t dIndex, uint32_t dData) {
 
 	uint32_t dWordSize = sizeof(uint64_t)*8;
 	
-	m_dHammingWeight -= HammingWeight(m_oData[dIndex/2]);
+	m_dHammingWeight -= HammingWeight(m_pData[dIndex/2]);
 	if(dWordSize==32)
-		m_oData[dIndex] = dData;
+		m_pData[dIndex] = dData;
 	else {
 		uint64_t dMask = 0;
 		if(dIndex%2) {
 			dMask = static_cast<uint64_t>(0xFFFFFFFF);
-			m_oData[dIndex/2] = (m_oData[dIndex/2] & dMask) | dData << (dWordSize/2);
+			m_pData[dIndex/2] = (m_pData[dIndex/2] & dMask) | dData << (dWordSize/2);
 		}
 		else {
 			dMask = static_cast<uint64_t>(0xFFFFFFFF) << (dWordSize/2);		
-			m_oData[dIndex/2] = (m_oData[dIndex/2] & dMask) | dData;
+			m_pData[dIndex/2] = (m_pData[dIndex/2] & dMask) | dData;
 		}
 	}
-	m_dHammingWeight += HammingWeight(m_oData[dIndex/2]);
+	m_dHammingWeight += HammingWeight(m_pData[dIndex/2]);
 }
 
 
 void
 CodeWord::Set64(uint64_t dIndex, uint64_t dData) {
-	m_dHammingWeight -= HammingWeight(m_oData[dIndex]);
-	m_oData[dIndex] = dData;
-	m_dHammingWeight += HammingWeight(m_oData[dIndex]);
+	m_dHammingWeight -= HammingWeight(m_pData[dIndex]);
+	m_pData[dIndex] = dData;
+	m_dHammingWeight += HammingWeight(m_pData[dIndex]);
 }
 
 void
 CodeWord::EraseBool(uint64_t dIndex) {
-	assert(dIndex < m_oData.size()*(sizeof(uint64_t)*8));
-	std::vector<uint64_t> vTemp = m_oData;
-	uint64_t dOldOffSet = m_dOffSet;
-	Clear();
-
-	for(uint64_t i = 0; i < vTemp.size()-1; i++) {
-		for(uint64_t j = 0; j < sizeof(uint64_t)*8; j++) {
-			if(i*sizeof(uint64_t)*8+j==dIndex)
-				continue;
-			PushBool((vTemp[i] >> ((sizeof(uint64_t)*8-1)-j)) & 1);
-		}
+	assert(dIndex < GetLength());
+	uint64_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dWord     = dIndex/dWordSize;
+	uint64_t dBit      = dIndex%dWordSize;
+
+	if(AtBool(dIndex))
+		m_dHammingWeight--;
+
+	// keep the bits in front of dIndex and shift the remaining bits by one
+	uint64_t dHighMask = dBit ? ~static_cast<uint64_t>(0) << (dWordSize-dBit) : 0;
+	uint64_t dLowMask  = (static_cast<uint64_t>(1) << (dWordSize-1-dBit)) - 1;
+	m_pData[dWord] = (m_pData[dWord] & dHighMask) | ((m_pData[dWord] & dLowMask) << 1);
+	for(uint64_t i = dWord+1; i < m_dLength64; i++) {
+		m_pData[i-1] |= m_pData[i] >> (dWordSize-1);
+		m_pData[i] <<= 1;
 	}
-	for(uint64_t j = 0; j < sizeof(uint64_t)*8-dOldOffSet; j++) {
-		if((vTemp.size()-1)*sizeof(uint64_t)*8+j==dIndex)
-			continue;
-		PushBool((vTemp[vTemp.size()-1] >> ((sizeof(uint64_t)*8-1)-j)) & 1);
+
+	m_dOffSet++;
+	if(m_dOffSet == dWordSize) {
+		ShrinkWord();
+		m_dOffSet = 0;
 	}
 }
 
 void
 CodeWord::Erase32(uint64_t dIndex) {
 	// can be more efficient
-	std::vector<uint64_t> vTemp = m_oData;
+	std::vector<uint64_t> vTemp = GetDataUInt64();
     Clear();
 	
 	if(sizeof(uint64_t)==4)
@@ -218,21 +246,22 @@ CodeWord::Erase32(uint64_t dIndex) {
 
 void
 CodeWord::Erase64(uint64_t dIndex) {
-	m_dHammingWeight -= HammingWeight(m_oData[dIndex]);
-	m_oData.erase(m_oData.begin()+dIndex);
+	m_dHammingWeight -= HammingWeight(m_pData[dIndex]);
+	memmove(m_pData+dIndex, m_pData+dIndex+1, (m_dLength64-dIndex-1)*sizeof(uint64_t));
+	ShrinkWord();
 }
 
 void
 CodeWord::PushBool(bool dData) {
 
 	if(m_dOffSet > 0) {
-		m_oData[m_oData.size()-1] = m_oData[m_oData.size()-1] 
+		m_pData[m_dLength64-1] = m_pData[m_dLength64-1] 
 		                                | (static_cast<uint64_t>(dData) << (m_dOffSet-1));
 		m_dOffSet--;
 	}
 	else {
 		m_dOffSet = sizeof(uint64_t)*8-1;
-		m_oData.push_back(static_cast<uint64_t>(dData) << m_dOffSet);
+		GrowWord(static_cast<uint64_t>(dData) << m_dOffSet);
 	}
 
 	if(dData)
@@ -247,7 +276,7 @@ CodeWord::Push32(uint32_t dData) {
 		for(uint32_t i = 0; i < sizeof(uint32_t)*8; i++)
 			this->PushBool((dData >> ((sizeof(uint32_t)*8-1)-i)) & 1);
 	else {
-		m_oData.push_back(static_cast<uint64_t>(dData) << (sizeof(uint32_t)*8));
+		GrowWord(static_cast<uint64_t>(dData) << (sizeof(uint32_t)*8));
 		m_dOffSet = (sizeof(uint64_t)-sizeof(uint32_t))*8;
 		m_dHammingWeight += HammingWeight(dData);
 	}
@@ -260,7 +289,7 @@ CodeWord::Push64(uint64_t dData) {
 		for(uint32_t i = 0; i < sizeof(uint64_t)*8; i++)
 			this->PushBool((dData >> ((sizeof(uint64_t)*8-1)-i)) & 1);
 	else {
-		m_oData.push_back(dData);
+		GrowWord(dData);
 		m_dHammingWeight += HammingWeight(dData);
 	}
 }
@@ -268,56 +297,97 @@ CodeWord::Push64(uint64_t dData) {
 
 void
 CodeWord::PopBool() {
-	m_dHammingWeight -= HammingWeight(m_oData[m_oData.size()-1]);
-	m_oData[m_oData.size()-1] = m_oData[m_oData.size()-1] & ~(static_cast<uint64_t>(1) << m_dOffSet);
+	m_dHammingWeight -= HammingWeight(m_pData[m_dLength64-1]);
+	m_pData[m_dLength64-1] = m_pData[m_dLength64-1] & ~(static_cast<uint64_t>(1) << m_dOffSet);
 	m_dOffSet++;
 	if(m_dOffSet == sizeof(uint64_t)*8)
 		m_dOffSet = 0;
-	m_dHammingWeight += HammingWeight(m_oData[m_oData.size()-1]);
+	m_dHammingWeight += HammingWeight(m_pData[m_dLength64-1]);
 }
 
 void
 CodeWord::Pop32() {
 
 	if(m_dOffSet < (sizeof(uint32_t)*8)) {
-		m_dHammingWeight -= HammingWeight(m_oData[m_oData.size()-1]);
+		m_dHammingWeight -= HammingWeight(m_pData[m_dLength64-1]);
 		for(uint32_t i = m_dOffSet; i < m_dOffSet+sizeof(uint32_t)*8; i++)
-			m_oData[m_oData.size()-1] = m_oData[m_oData.size()-1] & ~(static_cast<uint64_t>(1) << i);
+			m_pData[m_dLength64-1] = m_pData[m_dLength64-1] & ~(static_cast<uint64_t>(1) << i);
 		m_dOffSet += sizeof(uint32_t)*8;
-		m_dHammingWeight += HammingWeight(m_oData[m_oData.size()-1]);
+		m_dHammingWeight += HammingWeight(m_pData[m_dLength64-1]);
 	}
 	else {
-		m_dHammingWeight -= HammingWeight(m_oData[m_oData.size()-1]);
-		m_oData.pop_back();
-		m_dHammingWeight -= HammingWeight(m_oData[m_oData.size()-1]);
+		m_dHammingWeight -= HammingWeight(m_pData[m_dLength64-1]);
+		ShrinkWord();
+		m_dHammingWeight -= HammingWeight(m_pData[m_dLength64-1]);
 		m_dOffSet -= sizeof(uint32_t)*8;
 		for(uint32_t i = 0; i < m_dOffSet; i++)
-			m_oData[m_oData.size()-1] = m_oData[m_oData.size()-1] & ~(static_cast<uint64_t>(1) << (m_dOffSet-1+i));
-		m_dHammingWeight += HammingWeight(m_oData[m_oData.size()-1]);
+			m_pData[m_dLength64-1] = m_pData[m_dLength64-1] & ~(static_cast<uint64_t>(1) << (m_dOffSet-1+i));
+		m_dHammingWeight += HammingWeight(m_pData[m_dLength64-1]);
 	}
 }
 
 void
 CodeWord::Pop64() {
-	m_dHammingWeight -= HammingWeight(m_oData[m_oData.size()-1]);
-	m_oData.pop_back();
+	m_dHammingWeight -= HammingWeight(m_pData[m_dLength64-1]);
+	ShrinkWord();
 	if(m_dOffSet > 0) {
 		for(uint32_t i = 0; i < m_dOffSet; i++) {
-			m_dHammingWeight -= HammingWeight(m_oData[m_oData.size()-1]);
-			m_oData[m_oData.size()-1] = m_oData[m_oData.size()-1] & ~(static_cast<uint64_t>(1) << (m_dOffSet-1+i));
-			m_dHammingWeight += HammingWeight(m_oData[m_oData.size()-1]);
+			m_dHammingWeight -= HammingWeight(m_pData[m_dLength64-1]);
+			m_pData[m_dLength64-1] = m_pData[m_dLength64-1] & ~(static_cast<uint64_t>(1) << (m_dOffSet-1+i));
+			m_dHammingWeight += HammingWeight(m_pData[m_dLength64-1]);
 		}
 	}
 }
 
 void
 CodeWord::Clear() {
+	assert(!m_bView);
 	m_dHammingWeight = 0;
 	m_oData.clear();
+	Sync();
 
 	m_dOffSet = 0;
 }
 
+void
+CodeWord::Reserve(uint64_t dLength) {
+	assert(!m_bView);
+	m_oData.reserve((dLength+sizeof(uint64_t)*8-1)/(sizeof(uint64_t)*8));
+	Sync();
+}
+
+void
+CodeWord::Resize(uint64_t dLength) {
+	uint64_t dWordSize = sizeof(uint64_t)*8;
+
+	assert(!m_bView);
+	m_oData.resize((dLength+dWordSize-1)/dWordSize, 0);
+	Sync();
+	m_dOffSet = static_cast<uint8_t>(m_dLength64*dWordSize-dLength);
+	// the unused bits of the last word are zero
+	if(m_dOffSet > 0)
+		m_pData[m_dLength64-1] &= ~static_cast<uint64_t>(0) << m_dOffSet;
+	m_dHammingWeight = RowWeight(m_pData, m_dLength64);
+}
+
+void
+CodeWord::Swap(CodeWord & oCodeWord) {
+	if(this == &oCodeWord)
+		return;
+
+	if(m_bView || oCodeWord.m_bView) {
+		assert(GetLength() == oCodeWord.GetLength());
+		std::swap_ranges(m_pData, m_pData+m_dLength64, oCodeWord.m_pData);
+	}
+	else {
+		m_oData.swap(oCodeWord.m_oData);
+		std::swap(m_dOffSet, oCodeWord.m_dOffSet);
+		Sync();
+		oCodeWord.Sync();
+	}
+	std::swap(m_dHammingWeight, oCodeWord.m_dHammingWeight);
+}
+
 void 
 CodeWord::PrintBool(const std::string oOutput) const {
 
@@ -391,21 +461,48 @@ CodeWord::Print64(const std::string oOutput) const {
 
 CodeWord & 
 CodeWord::operator=(const CodeWord & oCodeWord) {
+	if(this == &oCodeWord)
+		return *this;
+
+	if(m_bView) {
+		assert(GetLength() == oCodeWord.GetLength());
+		memcpy(m_pData, oCodeWord.m_pData, m_dLength64*sizeof(uint64_t));
+	}
+	else {
+		m_oData.assign(oCodeWord.m_pData, oCodeWord.m_pData+oCodeWord.m_dLength64);
+		Sync();
+	}
 	m_dHammingWeight = oCodeWord.m_dHammingWeight;
-	m_oData = oCodeWord.m_oData;
 
 	m_dOffSet = oCodeWord.m_dOffSet;
 	return *this;
 }
 
+CodeWord &
+CodeWord::operator=(CodeWord && oCodeWord) {
+	if(this == &oCodeWord)
+		return *this;
+
+	// a view keeps its memory, the data of a view can not be taken
+	if(m_bView || oCodeWord.m_bView)
+		return *this = static_cast<const CodeWord&>(oCodeWord);
+
+	m_oData.swap(oCodeWord.m_oData);
+	m_dHammingWeight = oCodeWord.m_dHammingWeight;
+	m_dOffSet        = oCodeWord.m_dOffSet;
+	Sync();
+	oCodeWord.Clear();
+	return *this;
+}
+
 CodeWord & 
 CodeWord::operator^=(const CodeWord & oCodeWord) {
 	
-	this->m_dHammingWeight = 0;
-	for(uint64_t i = 0; i < oCodeWord.m_oData.size(); i++) {
-		this->m_oData[i] ^= oCodeWord.m_oData[i];
-		this->m_dHammingWeight += HammingWeight(this->m_oData[i]);
-	}
+	// xor and weight in one pass, see RowKernels.h
+	this->m_dHammingWeight = RowXorWeight(this->m_pData, oCodeWord.m_pData, oCodeWord.m_dLength64);
+	if( this->m_dLength64 > oCodeWord.m_dLength64 )
+		this->m_dHammingWeight += RowWeight(this->m_pData+oCodeWord.m_dLength64,
+		                                    this->m_dLength64-oCodeWord.m_dLength64);
 	if( this->m_dOffSet < oCodeWord.m_dOffSet )
 		this->m_dOffSet = oCodeWord.m_dOffSet;
 	return *this;
@@ -425,4 +522,47 @@ CodeWord::operator==(const CodeWord & oOther) const {
 	return true;
  }
 
+void
+CodeWord::Bind(uint64_t * pData, uint64_t dLength, uint64_t dHammingWeight) {
+	uint64_t dWordSize = sizeof(uint64_t)*8;
+
+	m_oData.clear();
+	m_bView          = true;
+	m_pData          = pData;
+	m_dLength64      = (dLength+dWordSize-1)/dWordSize;
+	m_dOffSet        = static_cast<uint8_t>(m_dLength64*dWordSize-dLength);
+	m_dHammingWeight = dHammingWeight;
+}
+
+void
+CodeWord::Rebind(uint64_t * pData) {
+	assert(m_bView);
+	m_pData = pData;
+}
+
+void
+CodeWord::GrowWord(uint64_t dData) {
+	assert(!m_bView);
+	m_oData.push_back(dData);
+	Sync();
+}
+
+void
+CodeWord::ShrinkWord() {
+	if(m_bView) {
+		m_pData[m_dLength64-1] = 0;
+		m_dLength64--;
+	}
+	else {
+		m_oData.pop_back();
+		Sync();
+	}
+}
+
+void
+CodeWord::Sync() {
+	m_pData     = m_oData.empty() ? NULL : &m_oData[0];
+	m_dLength64 = m_oData.size();
+}
+
 //EOF
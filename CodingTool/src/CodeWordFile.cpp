@@ -23,88 +23,184 @@
 
 #include "CodeWordFile.h"
 
-CodeWordFile::CodeWordFile() : m_sFileName(""){
+#include <cctype>
+
+CodeWordFile::CodeWordFile()
+  : m_sFileName(""), m_dFlushInterval(5), m_bBinary(false), m_bBinaryInput(false) {
 }
 
-CodeWordFile::CodeWordFile(std::string & sFileName) : m_sFileName(sFileName){
+CodeWordFile::CodeWordFile(std::string & sFileName)
+  : m_sFileName(sFileName), m_dFlushInterval(5), m_bBinary(false), m_bBinaryInput(false) {
 }
 
 CodeWordFile::~CodeWordFile(void){
+	Close();
 }
 
 bool
 CodeWordFile::Read(const std::string & sFileName) {
 	
-	std::fstream oStream;
-
-	m_sFileName = sFileName;
-	oStream.open(sFileName.c_str(), std::ios::in);
-	if( oStream.fail()) {
-		std::cout << "Error: The file " << sFileName << " does not exist." << std::endl;
+	if(!Open(sFileName))
 		return false;
-	}
 
-	ReadHeader(oStream);
-	ReadCodeWords(oStream);
+	CodeWord oCodeWord;
+	while(Next(oCodeWord))
+		m_oCodeWordList.push_back(oCodeWord);
 
-	oStream.close();
+	m_oInput.close();
 	return true;
 }
 
 bool
 CodeWordFile::Write(const std::string & sFileName) {
-	std::fstream oStream;
 
+	Close();
 	m_sFileName = sFileName;
-	oStream.open(sFileName.c_str(), std::ios::out);
-	if( oStream.fail()) {
+	m_oOutput.clear();
+	m_oOutput.open(sFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+	if( m_oOutput.fail()) {
 		std::cout << "Error: The file " << sFileName << " could not be written." << std::endl;
 		return false;
 	}
 
-	WriteHeader(oStream);
-	//WriteCodeWords(oStream);
+	WriteHeader(m_oOutput);
+	if(m_bBinary)
+		m_oOutput << "%BINARY" << std::endl;
 
-	oStream.close();
+	m_oOutput.flush();
+	m_oLastFlush = Clock::now();
 	return true;
 }
 
 bool 
 CodeWordFile::WriteCodeWord(const CodeWord & oCodeWord) {
-	std::fstream oFileStream;
 
 	if(m_sFileName.compare("") == 0) {
 		std::cout << "Error: Missing file name." << std::endl;
 		return false;
 	}
 
-	oFileStream.open(m_sFileName.c_str(), std::ios::app | std::ios::out);
-	if( oFileStream.fail()) {
+	// the header was not written by this object, append to the file
+	if(!m_oOutput.is_open()) {
+		m_oOutput.clear();
+		m_oOutput.open(m_sFileName.c_str(), std::ios::app | std::ios::out | std::ios::binary);
+		if( m_oOutput.fail()) {
+			std::cout << "Error: The file " << m_sFileName << " could not be written." << std::endl;
+			return false;
+		}
+		m_oLastFlush = Clock::now();
+	}
+
+	if(m_bBinary)
+		FormatBinary(oCodeWord);
+	else
+		FormatText(oCodeWord);
+
+	if(m_sBuffer.size() >= BUFFERSIZE)
+		return Flush();
+	return FlushIfDue();
+}
+
+bool
+CodeWordFile::Flush() {
+	if(!m_oOutput.is_open())
+		return true;
+
+	if(!m_sBuffer.empty()) {
+		m_oOutput.write(m_sBuffer.data(), m_sBuffer.size());
+		m_sBuffer.clear();
+	}
+	m_oOutput.flush();
+	m_oLastFlush = Clock::now();
+
+	if(m_oOutput.fail()) {
 		std::cout << "Error: The file " << m_sFileName << " could not be written." << std::endl;
 		return false;
 	}
+	return true;
+}
 
-	// write HW on first position
-	oFileStream << oCodeWord.GetHammingWeight() << " ";
-	for (uint32_t i = 0; i < oCodeWord.GetLength(); i++) {
-		if(i == (oCodeWord.GetLength()-1))
-			oFileStream << oCodeWord.AtBool(i);
-		else
-			oFileStream << oCodeWord.AtBool(i) << " ";
+bool
+CodeWordFile::FlushIfDue() {
+	if(m_sBuffer.empty())
+		return true;
+	if(Clock::now()-m_oLastFlush < std::chrono::seconds(m_dFlushInterval))
+		return true;
+	return Flush();
+}
+
+void
+CodeWordFile::Close() {
+	if(m_oOutput.is_open()) {
+		Flush();
+		m_oOutput.close();
+	}
+	if(m_oInput.is_open())
+		m_oInput.close();
+}
+
+void
+CodeWordFile::SetFlushInterval(uint64_t dSeconds) {
+	m_dFlushInterval = dSeconds;
+}
+
+void
+CodeWordFile::SetBinary(bool bBinary) {
+	m_bBinary = bBinary;
+}
+
+bool
+CodeWordFile::Open(const std::string & sFileName) {
+
+	m_sFileName = sFileName;
+	if(m_oInput.is_open())
+		m_oInput.close();
+	m_oInput.clear();
+	m_oInput.open(sFileName.c_str(), std::ios::in | std::ios::binary);
+	if( m_oInput.fail()) {
+		std::cout << "Error: The file " << sFileName << " does not exist." << std::endl;
+		return false;
+	}
+
+	ReadHeader(m_oInput);
+
+	// binary records are announced after the header
+	m_bBinaryInput = false;
+	std::streampos oStart = m_oInput.tellg();
+	std::string sLine;
+	if(getline(m_oInput,sLine) && sLine.compare(0, 7, "%BINARY") == 0)
+		m_bBinaryInput = true;
+	else {
+		m_oInput.clear();
+		m_oInput.seekg(oStart);
 	}
-	oFileStream << std::endl;
 	return true;
 }
 
+bool
+CodeWordFile::Next(CodeWord & oCodeWord) {
+	if(!m_oInput.is_open())
+		return false;
+
+	if(m_bBinaryInput)
+		return ReadBinary(oCodeWord);
+
+	std::string sLine;
+	while(getline(m_oInput,sLine))
+		if(ParseText(sLine, oCodeWord))
+			return true;
+	return false;
+}
+
 void
 CodeWordFile::AddText(const std::string & sText) {
 	m_sText = sText;
 }
 
 bool
-CodeWordFile::ReadHeader(std::fstream & oFileStream) {
+CodeWordFile::ReadHeader(std::istream & oFileStream) {
 	std::string sLine, sParameter;
-	uint32_t dValue;
+	uint64_t dValue = 0;
 	std::stringstream sStream;
 	std::string sValue;
 	
@@ -157,7 +253,7 @@ CodeWordFile::ReadHeader(std::fstream & oFileStream) {
 }
 
 void
-CodeWordFile::WriteHeader(std::fstream & oFileStream) {
+CodeWordFile::WriteHeader(std::ostream & oFileStream) {
 
 	oFileStream << "%BEGIN" << std::endl;
 	oFileStream << "Info: " << m_sText << std::endl;
@@ -176,33 +272,94 @@ CodeWordFile::WriteHeader(std::fstream & oFileStream) {
 }
 
 void
-CodeWordFile::ReadCodeWords(std::fstream & oFileStream) {
+CodeWordFile::FormatText(const CodeWord & oCodeWord) {
+	uint64_t dLength = oCodeWord.GetLength();
 
-	CodeWord oCodeWord;
-	std::stringstream sStream;
-	std::string sLine;
-	uint16_t dValue;
-	bool bFirst = true;
+	// write HW on first position
+	m_sBuffer += std::to_string(oCodeWord.GetHammingWeight());
+	m_sBuffer += ' ';
+
+	size_t dPos = m_sBuffer.size();
+	m_sBuffer.resize(dPos + (dLength > 0 ? 2*dLength-1 : 0));
+	for(uint64_t i = 0; i < oCodeWord.GetLength64(); i++) {
+		uint64_t dWord  = oCodeWord.At64(i);
+		uint64_t dBits  = dLength-i*64 < 64 ? dLength-i*64 : 64;
+		for(uint64_t j = 0; j < dBits; j++) {
+			m_sBuffer[dPos++] = static_cast<char>('0' + ((dWord >> (dBits-1-j)) & 1));
+			if(dPos < m_sBuffer.size())
+				m_sBuffer[dPos++] = ' ';
+		}
+	}
+	m_sBuffer += '\n';
+}
 
-	while( !oFileStream.eof() ) {
-		getline(oFileStream,sLine);
+void
+CodeWordFile::FormatBinary(const CodeWord & oCodeWord) {
+	uint64_t dLength = oCodeWord.GetLength();
+	uint64_t aRecord[2] = { oCodeWord.GetHammingWeight(), dLength };
+	m_sBuffer.append(reinterpret_cast<const char*>(aRecord), sizeof(aRecord));
+
+	for(uint64_t i = 0; i < oCodeWord.GetLength64(); i++) {
+		// At64 returns the last word right aligned
+		uint64_t dWord = oCodeWord.At64(i);
+		if(i == oCodeWord.GetLength64()-1 && dLength%64 != 0)
+			dWord <<= 64-dLength%64;
+		m_sBuffer.append(reinterpret_cast<const char*>(&dWord), sizeof(dWord));
+	}
+}
+
+bool
+CodeWordFile::ParseText(const std::string & sLine, CodeWord & oCodeWord) {
+	size_t i = 0;
+
+	oCodeWord.Clear();
 
-		if( sLine.compare("") != 0 ) {
-			sStream << sLine;// << std::endl;
-			bFirst = true;
-			while( sStream.good()) {
-				sStream >> dValue;
-				// first number is weight
-				if(bFirst)
-					bFirst = false;
-				else
-					oCodeWord.PushBool(static_cast<bool>(dValue));
-			}
-			m_oCodeWordList.push_back(oCodeWord);
+	// first number is weight
+	while(i < sLine.size() && isspace(static_cast<unsigned char>(sLine[i])))
+		i++;
+	if(i == sLine.size())
+		return false;
+	while(i < sLine.size() && !isspace(static_cast<unsigned char>(sLine[i])))
+		i++;
+
+	uint64_t dWord = 0, dBits = 0;
+	for(; i < sLine.size(); i++) {
+		if(sLine[i] != '0' && sLine[i] != '1')
+			continue;
+		dWord = (dWord << 1) | static_cast<uint64_t>(sLine[i]-'0');
+		if(++dBits == 64) {
+			oCodeWord.Push64(dWord);
+			dWord = dBits = 0;
+		}
+	}
+	for(uint64_t j = 0; j < dBits; j++)
+		oCodeWord.PushBool((dWord >> (dBits-1-j)) & 1);
+	return true;
+}
+
+bool
+CodeWordFile::ReadBinary(CodeWord & oCodeWord) {
+	uint64_t aRecord[2];
+
+	oCodeWord.Clear();
+	if(!m_oInput.read(reinterpret_cast<char*>(aRecord), sizeof(aRecord)))
+		return false;
+
+	uint64_t dLength = aRecord[1];
+	for(uint64_t i = 0; i < (dLength+63)/64; i++) {
+		uint64_t dWord;
+		if(!m_oInput.read(reinterpret_cast<char*>(&dWord), sizeof(dWord))) {
+			std::cout << "Error: The file " << m_sFileName << " ends within a record." << std::endl;
 			oCodeWord.Clear();
-			sStream.clear();
+			return false;
 		}
+		if(dLength-i*64 >= 64)
+			oCodeWord.Push64(dWord);
+		else
+			for(uint64_t j = 0; j < dLength-i*64; j++)
+				oCodeWord.PushBool((dWord >> (63-j)) & 1);
 	}
+	return true;
 }
 
 void
@@ -0,0 +1,151 @@
+/*!
+  \file CollisionIndex.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class CollisionIndex.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CollisionIndex.h"
+
+CollisionIndex::CollisionIndex(void) : m_dMask(0), m_dShift(64), m_dEpoch(1) {
+}
+
+CollisionIndex::~CollisionIndex(void) {
+}
+
+void
+CollisionIndex::Reserve(uint64_t dEntries) {
+	m_vEntries.reserve(dEntries);
+	if(2*dEntries > m_vSlots.size())
+		Resize(2*dEntries);
+}
+
+void
+CollisionIndex::Grow() {
+	Resize(2*m_vSlots.size());
+}
+
+void
+CollisionIndex::Resize(uint64_t dMinSlots) {
+	uint64_t dSlots = 16;
+	uint32_t dBits  = 4;
+	while(dSlots < dMinSlots) {
+		dSlots <<= 1;
+		dBits++;
+	}
+
+	std::vector<Slot> vOld;
+	vOld.swap(m_vSlots);
+	uint32_t dOldEpoch = m_dEpoch;
+
+	Slot oEmpty = {0, 0, NONE};
+	m_vSlots.assign(dSlots, oEmpty);
+	m_dMask  = dSlots-1;
+	m_dShift = 64-dBits;
+	m_dEpoch = 1;
+
+	// the entries do not depend on the table, only the slots are moved
+	for(uint64_t i = 0; i < vOld.size(); i++) {
+		if(vOld[i].dEpoch != dOldEpoch)
+			continue;
+		uint64_t dSlot = Hash(vOld[i].dKey);
+		while(m_vSlots[dSlot].dEpoch == m_dEpoch)
+			dSlot = (dSlot+1) & m_dMask;
+		m_vSlots[dSlot].dKey   = vOld[i].dKey;
+		m_vSlots[dSlot].dHead  = vOld[i].dHead;
+		m_vSlots[dSlot].dEpoch = m_dEpoch;
+	}
+}
+
+void
+CollisionIndex::Insert(uint64_t dKey, uint32_t dCombination, uint32_t dRows) {
+	// keep the load factor below one half
+	if(2*(m_vEntries.size()+1) > m_vSlots.size())
+		Grow();
+
+	uint64_t dSlot = Hash(dKey);
+	while(m_vSlots[dSlot].dEpoch == m_dEpoch && m_vSlots[dSlot].dKey != dKey)
+		dSlot = (dSlot+1) & m_dMask;
+
+	Entry oEntry;
+	oEntry.dCombination = dCombination;
+	oEntry.dRows        = dRows;
+
+	Slot & oSlot = m_vSlots[dSlot];
+	if(oSlot.dEpoch == m_dEpoch)
+		oEntry.dNext = oSlot.dHead;
+	else {
+		oEntry.dNext = NONE;
+		oSlot.dKey   = dKey;
+		oSlot.dEpoch = m_dEpoch;
+	}
+	oSlot.dHead = static_cast<uint32_t>(m_vEntries.size());
+	m_vEntries.push_back(oEntry);
+}
+
+const CollisionIndex::Entry *
+CollisionIndex::Find(uint64_t dKey) const {
+	if(m_vSlots.empty())
+		return NULL;
+
+	uint64_t dSlot = Hash(dKey);
+	while(m_vSlots[dSlot].dEpoch == m_dEpoch) {
+		if(m_vSlots[dSlot].dKey == dKey)
+			return &m_vEntries[m_vSlots[dSlot].dHead];
+		dSlot = (dSlot+1) & m_dMask;
+	}
+	return NULL;
+}
+
+const CollisionIndex::Entry *
+CollisionIndex::Next(const Entry * pEntry) const {
+	if(pEntry->dNext == NONE)
+		return NULL;
+	return &m_vEntries[pEntry->dNext];
+}
+
+void
+CollisionIndex::Clear() {
+	m_vEntries.clear();
+	m_dEpoch++;
+	// after a wrap around old tags could become valid again
+	if(m_dEpoch == 0) {
+		for(uint64_t i = 0; i < m_vSlots.size(); i++)
+			m_vSlots[i].dEpoch = 0;
+		m_dEpoch = 1;
+	}
+}
+
+uint64_t
+CollisionIndex::GetEntries() const {
+	return m_vEntries.size();
+}
+
+uint64_t
+CollisionIndex::GetMemory() const {
+	return m_vSlots.capacity()*sizeof(Slot) + m_vEntries.capacity()*sizeof(Entry);
+}
+
+uint64_t
+CollisionIndex::Hash(uint64_t dKey) const {
+	// Fibonacci hashing, the upper bits of the product are well mixed
+	return (dKey*0x9E3779B97F4A7C15ULL) >> m_dShift;
+}
+
+//EOF
@@ -0,0 +1,150 @@
+/*!
+  \file ColumnGather.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class ColumnGather.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ColumnGather.h"
+#include "HammingWeight.h"
+#include "RowKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLUMNGATHER_X86
+#include <immintrin.h>
+#endif
+
+//! Portable parallel bit extract.
+static inline uint64_t
+ExtractBits(uint64_t dData, uint64_t dMask) {
+	uint64_t dResult = 0;
+	uint64_t dBit    = 1;
+	for(; dMask != 0; dMask &= dMask-1) {
+		if(dData & dMask & (~dMask+1))
+			dResult |= dBit;
+		dBit <<= 1;
+	}
+	return dResult;
+}
+
+//! Writes a field which ends at bit dEnd (MSB first) of the destination word.
+static inline void
+PutBits(uint64_t * pDst, uint64_t dData, uint32_t dEnd) {
+	*pDst |= dData << (64-dEnd);
+}
+
+template<typename RunType>
+static inline void
+GatherScalar(const RunType * pRuns, uint64_t dRuns, const uint64_t * pSrc, uint64_t * pDst) {
+	for(uint64_t i = 0; i < dRuns; i++)
+		PutBits(pDst+pRuns[i].dDstWord, ExtractBits(pSrc[pRuns[i].dSrcWord], pRuns[i].dMask), pRuns[i].dDstEnd);
+}
+
+#ifdef COLUMNGATHER_X86
+template<typename RunType>
+__attribute__((target("bmi2")))
+static void
+GatherPext(const RunType * pRuns, uint64_t dRuns, const uint64_t * pSrc, uint64_t * pDst) {
+	for(uint64_t i = 0; i < dRuns; i++)
+		PutBits(pDst+pRuns[i].dDstWord, _pext_u64(pSrc[pRuns[i].dSrcWord], pRuns[i].dMask), pRuns[i].dDstEnd);
+}
+#endif
+
+ColumnGather::ColumnGather(void)
+  : m_dColumns(0), m_dWords(0), m_bPext(false) {
+}
+
+ColumnGather::ColumnGather(const std::vector<uint64_t> & vCols)
+  : m_dColumns(0), m_dWords(0), m_bPext(false) {
+	SetColumns(vCols);
+}
+
+ColumnGather::~ColumnGather(void) {
+}
+
+void
+ColumnGather::SetColumns(const std::vector<uint64_t> & vCols) {
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+
+	m_vRuns.clear();
+	m_dColumns = vCols.size();
+	m_dWords   = (m_dColumns+dWordSize-1)/dWordSize;
+
+	for(uint64_t i = 0; i < vCols.size(); i++) {
+		uint64_t dBit = static_cast<uint64_t>(1) << (dWordSize-1-vCols[i]%dWordSize);
+
+		// a new run starts if the word changes, if the columns are not
+		// ascending (PEXT keeps the bit order) or at a destination word,
+		// hence a run never spans two destination words
+		if( m_vRuns.empty() || m_vRuns.back().dSrcWord != vCols[i]/dWordSize ||
+		    dBit >= (m_vRuns.back().dMask & (~m_vRuns.back().dMask+1)) ||
+		    i % dWordSize == 0 ) {
+			Run oRun;
+			oRun.dMask    = 0;
+			oRun.dSrcWord = static_cast<uint32_t>(vCols[i]/dWordSize);
+			oRun.dDstWord = static_cast<uint32_t>(i/dWordSize);
+			oRun.dDstEnd  = static_cast<uint32_t>(i%dWordSize);
+			m_vRuns.push_back(oRun);
+		}
+		m_vRuns.back().dMask |= dBit;
+		m_vRuns.back().dDstEnd++;
+	}
+
+#ifdef COLUMNGATHER_X86
+	// the scalar kernel selection also disables PEXT
+	m_bPext = __builtin_cpu_supports("bmi2") && GetRowKernel() != KERNEL_SCALAR;
+#endif
+}
+
+uint64_t
+ColumnGather::Gather(const uint64_t * pSrc, uint64_t * pDst) const {
+	for(uint64_t i = 0; i < m_dWords; i++)
+		pDst[i] = 0;
+
+#ifdef COLUMNGATHER_X86
+	if(m_bPext)
+		GatherPext(m_vRuns.data(), m_vRuns.size(), pSrc, pDst);
+	else
+#endif
+		GatherScalar(m_vRuns.data(), m_vRuns.size(), pSrc, pDst);
+
+	// the columns fill the destination from the most significant bit,
+	// the unused bits of the last word stay zero
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < m_dWords; i++)
+		dWeight += HammingWeight(pDst[i]);
+	return dWeight;
+}
+
+uint64_t
+ColumnGather::GetColumns() const {
+	return m_dColumns;
+}
+
+uint64_t
+ColumnGather::GetWords() const {
+	return m_dWords;
+}
+
+uint64_t
+ColumnGather::GetRuns() const {
+	return m_vRuns.size();
+}
+
+//EOF
@@ -0,0 +1,53 @@
+/*!
+  \file DumerEngine.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class DumerEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "DumerEngine.h"
+
+DumerEngine::DumerEngine(void) {
+}
+
+DumerEngine::~DumerEngine(void) {
+}
+
+IsdEngine *
+DumerEngine::Clone() const {
+	return new DumerEngine(*this);
+}
+
+const char *
+DumerEngine::GetName() const {
+	return "dumer";
+}
+
+void
+DumerEngine::Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback) {
+
+	Project(oZ, m_dSigma, oRnGen);
+
+	m_oList.Clear();
+	Enumerate(0, oZ.GetRows(), 1, m_dP, m_oList);
+
+	Collide(m_oList, oCallback);
+}
+
+//EOF
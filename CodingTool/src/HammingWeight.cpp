@@ -25,24 +25,20 @@
 
 uint32_t
 HammingWeight(uint64_t dWord) {
-	uint32_t dBytes = sizeof(dWord);
-	if(dBytes == 4)
-		return ( (hwt[dWord & 0xFF] + hwt[(dWord>>8) & 0xFF] + hwt[(dWord>>16) & 0xFF] + hwt[(dWord>>24) & 0xFF]) );
-	else if(dBytes ==8)
-		return ( (hwt[dWord & 0xFF] + hwt[(dWord>>8) & 0xFF] + hwt[(dWord>>16) & 0xFF] + hwt[(dWord>>24) & 0xFF]) +
-				 (hwt[dWord>>32 & 0xFF] + hwt[(dWord>>40) & 0xFF] + hwt[(dWord>>48) & 0xFF] + hwt[(dWord>>56) & 0xFF]));
-	return 0;
+	// parallel bit count, avoids the eight table lookups of hwt
+	dWord = dWord - ((dWord >> 1) & 0x5555555555555555ULL);
+	dWord = (dWord & 0x3333333333333333ULL) + ((dWord >> 2) & 0x3333333333333333ULL);
+	dWord = (dWord + (dWord >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return static_cast<uint32_t>((dWord * 0x0101010101010101ULL) >> 56);
 }
 
 uint64_t
 HammingWeight(uint64_t dWord, std::vector<uint64_t> & vWeights) {
-	uint32_t dBytes = sizeof(dWord);
 	uint64_t dWeight = 0;
 
-	for(uint64_t i = 0; i < dBytes*8; i++) {
-		if( (dWord >> ((dBytes*8-1)-i)) & 1 )
-			dWeight += vWeights[i];
-	}
+	// only the set bits are visited, the most significant bit is bit 0
+	for(; dWord != 0; dWord &= dWord-1)
+		dWeight += vWeights[63-__builtin_ctzll(dWord)];
 	return dWeight;
 }
 
@@ -40,6 +40,32 @@ InputHandler::InputHandler(Parameters & oParameters) : m_oParameters(oParameters
 		"\t -cw \t read a code word file");
 	m_oParameters.AddParameter(Parameters::CMFILE,""
 		,"\t -cm \t read a file containing a code matrix");
+	m_oParameters.AddParameter(Parameters::THREADS,1,
+		"\t -t \t number of parallel search chains, 0 uses all cores (default is 1)");
+	m_oParameters.AddParameter(Parameters::BINARYCW,0,
+		"\t -ob \t write binary records to the output file (default is text)");
+	m_oParameters.AddParameter(Parameters::ALGORITHM,"cc",
+		"\t -a \t search algorithm: cc, stern, dumer or mmt (default is cc)");
+	m_oParameters.AddParameter(Parameters::P,2,
+		"\t -p \t rows per combination (default is 2)");
+	m_oParameters.AddParameter(Parameters::CHECKPOINT,"",
+		"\t -cp \t checkpoint file, the search state is saved periodically");
+	m_oParameters.AddParameter(Parameters::CHECKPOINTTIME,600,
+		"\t -ct \t seconds between two checkpoints (default is 600)");
+	m_oParameters.AddParameter(Parameters::RESUME,"",
+		"\t -r \t resume the search from the given checkpoint file");
+	m_oParameters.AddParameter(Parameters::STATISTICS,"",
+		"\t -sf \t statistics file, CSV if it ends with .csv, otherwise JSON lines");
+	m_oParameters.AddParameter(Parameters::STATISTICSTIME,10,
+		"\t -st \t seconds between two lines of the statistics file (default is 10)");
+	m_oParameters.AddParameter(Parameters::SEED,0,
+		"\t -sd \t seed of the random number generators, 0 draws a random seed (default is 0)");
+	m_oParameters.AddParameter(Parameters::CHECKMATRIX,0,
+		"\t -hm \t the code matrix is a parity-check matrix (default is a generator matrix)");
+	m_oParameters.AddParameter(Parameters::BOARD,"",
+		"\t -bd \t name of the shared memory board of a multi-process search (see coordinator)");
+	m_oParameters.AddParameter(Parameters::PIN,0,
+		"\t -pn \t pin the search chains to cores, spread over the NUMA nodes (default 0)");
 }
 
 InputHandler::~InputHandler() {
@@ -53,7 +79,7 @@ InputHandler::ParseSettings(int argc, const char* argv[]) {
 
 	for(int i = 1; i < argc; i++) {
 		std::string sPara(argv[i]);
-		int dValue = -1;
+		uint64_t dValue = 0;
 		sStream.clear();
 		if(sPara.compare("-h") == 0 || argc <= 1) {
 			bError = true;
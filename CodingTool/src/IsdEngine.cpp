@@ -0,0 +1,299 @@
+/*!
+  \file IsdEngine.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the classes IsdEngine and IsdCallback.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+
+#include "IsdEngine.h"
+#include "CanteautChabaudEngine.h"
+#include "SternEngine.h"
+#include "DumerEngine.h"
+#include "MMTEngine.h"
+
+IsdCallback::~IsdCallback(void) {
+}
+
+IsdEngine::IsdEngine(void) : m_dSigma(20), m_dP(2) {
+}
+
+IsdEngine::~IsdEngine(void) {
+}
+
+IsdEngine *
+IsdEngine::Create(const std::string & sName) {
+	if(sName == "cc")
+		return new CanteautChabaudEngine;
+	if(sName == "stern")
+		return new SternEngine;
+	if(sName == "dumer")
+		return new DumerEngine;
+	if(sName == "mmt")
+		return new MMTEngine;
+	return NULL;
+}
+
+bool
+IsdEngine::SetParameters(Parameters & oParameters) {
+	m_dSigma = oParameters.GetIntegerParameter(Parameters::SIGMA);
+	m_dP     = static_cast<uint32_t>(oParameters.GetIntegerParameter(Parameters::P));
+
+	if(m_dSigma == 0 || m_dSigma > MAXSIGMA) {
+		std::cout << "Error: sigma has to be between 1 and " << MAXSIGMA << "." << std::endl;
+		return false;
+	}
+	if(m_dP == 0 || m_dP > MAXP) {
+		std::cout << "Error: p has to be between 1 and " << MAXP << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void
+IsdEngine::LimitSigma(uint64_t dColumns) {
+	assert(dColumns > 0);
+	if(m_dSigma > dColumns) {
+		std::cout << "Info: sigma is larger than the " << dColumns << " redundant columns, sigma = "
+		          << dColumns << " is used." << std::endl;
+		m_dSigma = dColumns;
+	}
+}
+
+void
+IsdEngine::Project(const CodeMatrix & oZ, uint64_t dColumns, RandomNumberGenerator & oRnGen) {
+	assert(dColumns > 0 && dColumns <= 64 && dColumns <= oZ.GetColumns());
+
+	if(m_vRows.size() != oZ.GetRows()) {
+		m_vRows.resize(oZ.GetRows());
+		for(uint64_t i = 0; i < m_vRows.size(); i++)
+			m_vRows[i] = i;
+	}
+
+	// sorted columns are extracted with fewer operations
+	uint64_t dStart = SearchStatistics::Now();
+
+	oRnGen.getRandomPosVector(0, oZ.GetColumns()-1, dColumns, m_vCols);
+	std::sort(m_vCols.begin(), m_vCols.end());
+	m_oGather.SetColumns(m_vCols);
+	oZ.GetSubMatrix(m_vRows, m_oGather, m_oWindow);
+
+	m_vProj.resize(m_vRows.size());
+	for(uint64_t i = 0; i < m_vRows.size(); i++)
+		m_vProj[i] = m_oWindow[i].At64(0);
+
+	m_oStatistics.dProjectTime += SearchStatistics::Now()-dStart;
+}
+
+void
+IsdEngine::Enumerate(uint64_t dFirst, uint64_t dLast, uint32_t dMinRows, uint32_t dMaxRows,
+                     CombinationList & oList) {
+	uint32_t aComb[MAXP+2];
+	uint16_t aRows[MAXP];
+	uint32_t dOut = 0;
+	uint32_t dIn  = 0;
+	uint32_t dN   = static_cast<uint32_t>(dLast-dFirst);
+	uint64_t dSize  = oList.Size();
+	uint64_t dStart = SearchStatistics::Now();
+
+	assert(dMaxRows <= MAXP && dLast <= m_vProj.size() && dLast <= MAXROWS);
+
+	for(uint32_t r = dMinRows; r <= dMaxRows && r <= dN; r++) {
+		if(r == 0)
+			continue;
+
+		// aComb[1..r] are the rows relative to dFirst, aComb[r+1] = dN
+		uint64_t dKey = 0;
+		for(uint32_t j = 1; j <= r; j++) {
+			aComb[j] = j-1;
+			dKey ^= m_vProj[dFirst+j-1];
+		}
+		aComb[r+1] = dN;
+
+		while(true) {
+			for(uint32_t j = 0; j < r; j++)
+				aRows[j] = static_cast<uint16_t>(dFirst+aComb[j+1]);
+			oList.Add(aRows, r, dKey);
+
+			if(!NextCombination(aComb, r, dOut, dIn))
+				break;
+			dKey ^= m_vProj[dFirst+dOut] ^ m_vProj[dFirst+dIn];
+		}
+	}
+
+	m_oStatistics.dCombinations  += oList.Size()-dSize;
+	m_oStatistics.dEnumerateTime += SearchStatistics::Now()-dStart;
+}
+
+bool
+IsdEngine::NextCombination(uint32_t * pComb, uint32_t dRows, uint32_t & dOut, uint32_t & dIn) {
+	uint32_t j = 2;
+	bool bDecrease;
+
+	// R3, the easy case changes only the smallest row
+	if(dRows & 1) {
+		if(pComb[1]+1 < pComb[2]) {
+			dOut = pComb[1]++;
+			dIn  = pComb[1];
+			return true;
+		}
+		bDecrease = true;
+	}
+	else {
+		if(pComb[1] > 0) {
+			dOut = pComb[1]--;
+			dIn  = pComb[1];
+			return true;
+		}
+		bDecrease = false;
+	}
+
+	while(j <= dRows) {
+		if(bDecrease) {
+			// R4, try to decrease pComb[j]
+			if(pComb[j] >= j) {
+				dOut       = pComb[j];
+				dIn        = j-2;
+				pComb[j]   = pComb[j-1];
+				pComb[j-1] = j-2;
+				return true;
+			}
+		}
+		else {
+			// R5, try to increase pComb[j]
+			if(pComb[j]+1 < pComb[j+1]) {
+				dOut       = pComb[j-1];
+				dIn        = pComb[j]+1;
+				pComb[j-1] = pComb[j];
+				pComb[j]++;
+				return true;
+			}
+		}
+		j++;
+		bDecrease = !bDecrease;
+	}
+	return false;
+}
+
+void
+IsdEngine::Emit(const uint16_t * pRows1, uint32_t dRows1, const uint16_t * pRows2, uint32_t dRows2,
+                IsdCallback & oCallback) const {
+	uint64_t aRows[2*MAXP];
+	uint32_t dRows = 0;
+
+	assert(2*MAXP <= MAXXORROWS);
+
+	// rows which occur in both combinations cancel out
+	for(uint32_t i = 0; i < dRows1; i++) {
+		uint32_t j = 0;
+		while(j < dRows2 && pRows2[j] != pRows1[i])
+			j++;
+		if(j == dRows2)
+			aRows[dRows++] = pRows1[i];
+	}
+	for(uint32_t j = 0; j < dRows2; j++) {
+		uint32_t i = 0;
+		while(i < dRows1 && pRows1[i] != pRows2[j])
+			i++;
+		if(i == dRows1)
+			aRows[dRows++] = pRows2[j];
+	}
+
+	if(dRows > 0)
+		oCallback.Candidate(aRows, dRows);
+}
+
+void
+IsdEngine::Collide(const CombinationList & oList1, const CombinationList & oList2, IsdCallback & oCallback,
+                   bool bLastOnly) {
+	const CollisionIndex::Entry * pEntry = NULL;
+	uint64_t dStart = SearchStatistics::Now();
+
+	m_oIndex.Clear();
+	m_oIndex.Reserve(oList1.Size());
+	for(uint64_t i = 0; i < oList1.Size(); i++)
+		m_oIndex.Insert(oList1.vKeys[i], static_cast<uint32_t>(i), oList1.vCount[i]);
+
+	for(uint64_t j = 0; j < oList2.Size() && !oCallback.IsStopped(); j++) {
+		for(pEntry = m_oIndex.Find(oList2.vKeys[j]); pEntry != NULL; pEntry = m_oIndex.Next(pEntry)) {
+			Emit(oList1.Rows(pEntry->dCombination), pEntry->dRows, oList2.Rows(j), oList2.vCount[j], oCallback);
+			m_oStatistics.dCollisions++;
+			if(bLastOnly)
+				break;
+		}
+	}
+	UpdateIndexStatistics(dStart);
+}
+
+void
+IsdEngine::Collide(const CombinationList & oList, IsdCallback & oCallback) {
+	const CollisionIndex::Entry * pEntry = NULL;
+	uint64_t dStart = SearchStatistics::Now();
+
+	m_oIndex.Clear();
+	m_oIndex.Reserve(oList.Size());
+	for(uint64_t j = 0; j < oList.Size() && !oCallback.IsStopped(); j++) {
+		for(pEntry = m_oIndex.Find(oList.vKeys[j]); pEntry != NULL; pEntry = m_oIndex.Next(pEntry)) {
+			Emit(oList.Rows(pEntry->dCombination), pEntry->dRows, oList.Rows(j), oList.vCount[j], oCallback);
+			m_oStatistics.dCollisions++;
+		}
+		m_oIndex.Insert(oList.vKeys[j], static_cast<uint32_t>(j), oList.vCount[j]);
+	}
+	UpdateIndexStatistics(dStart);
+}
+
+void
+IsdEngine::UpdateIndexStatistics(uint64_t dStart) {
+	m_oStatistics.dCollideTime += SearchStatistics::Now()-dStart;
+	if(m_oIndex.GetMemory() > m_oStatistics.dIndexMemory)
+		m_oStatistics.dIndexMemory = m_oIndex.GetMemory();
+}
+
+SearchStatistics &
+IsdEngine::GetStatistics() {
+	return m_oStatistics;
+}
+
+void
+IsdEngine::CombinationList::Clear() {
+	vRows.clear();
+	vCount.clear();
+	vKeys.clear();
+}
+
+uint64_t
+IsdEngine::CombinationList::Size() const {
+	return vKeys.size();
+}
+
+void
+IsdEngine::CombinationList::Add(const uint16_t * pRows, uint32_t dCount, uint64_t dKey) {
+	for(uint32_t i = 0; i < MAXP; i++)
+		vRows.push_back(i < dCount ? pRows[i] : 0);
+	vCount.push_back(static_cast<uint8_t>(dCount));
+	vKeys.push_back(dKey);
+}
+
+const uint16_t *
+IsdEngine::CombinationList::Rows(uint64_t dIndex) const {
+	return &vRows[dIndex*MAXP];
+}
+
+//EOF
@@ -24,9 +24,84 @@
 
 #include "LowWeightSearch.h"
 
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOWWEIGHTSEARCH_FSYNC
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#include <dirent.h>
+#endif
+
+//! Magic at the start of a checkpoint file.
+static const char CHECKPOINTMAGIC[8] = {'C','T','S','E','A','R','C','H'};
+//! Version of the checkpoint format.
+static const uint32_t CHECKPOINTVERSION = 2;
+//! Written as 64-bit word to detect files of a different byte order.
+static const uint64_t CHECKPOINTORDER = 0x0102030405060708ULL;
+
+//! The header of a checkpoint file, followed by the data of LowWeightSearch::WriteCheckpoint.
+struct CheckpointHeader {
+	char     aMagic[8];      //!< "CTSEARCH".
+	uint32_t dVersion;       //!< Version of the format.
+	uint32_t dChains;        //!< Number of chains.
+	uint64_t dRows;          //!< Number of rows of the generator matrix.
+	uint64_t dColumns;       //!< Number of columns of the generator matrix.
+	uint64_t dMinWeight;     //!< The minimum weight.
+	uint64_t dMinimumChain;  //!< Index of the chain which found the minimum.
+	uint64_t dByteOrder;     //!< CHECKPOINTORDER in the byte order of the machine.
+};
+
+static void
+WriteVector(std::ostream & oStream, const std::vector<uint64_t> & vData) {
+	uint64_t dSize = vData.size();
+	oStream.write(reinterpret_cast<const char*>(&dSize), sizeof(dSize));
+	if(dSize > 0)
+		oStream.write(reinterpret_cast<const char*>(&vData[0]), dSize*sizeof(uint64_t));
+}
+
+static bool
+ReadVector(std::istream & oStream, std::vector<uint64_t> & vData, uint64_t dMaxSize) {
+	uint64_t dSize = 0;
+	oStream.read(reinterpret_cast<char*>(&dSize), sizeof(dSize));
+	if(oStream.fail() || dSize > dMaxSize)
+		return false;
+	vData.resize(dSize);
+	if(dSize > 0)
+		oStream.read(reinterpret_cast<char*>(&vData[0]), dSize*sizeof(uint64_t));
+	return !oStream.fail();
+}
+
+#ifdef __linux__
+//! Returns the NUMA node of a core, 0 if the kernel has no NUMA support.
+static uint32_t
+CpuNode(uint32_t dCpu) {
+	std::string sPath = "/sys/devices/system/cpu/cpu" + std::to_string(dCpu);
+	uint32_t dNode = 0;
+	DIR * pDir = opendir(sPath.c_str());
+	if(pDir == NULL)
+		return 0;
+	struct dirent * pEntry;
+	while((pEntry = readdir(pDir)) != NULL) {
+		if(strncmp(pEntry->d_name, "node", 4) == 0 && pEntry->d_name[4] >= '0' && pEntry->d_name[4] <= '9') {
+			dNode = static_cast<uint32_t>(strtoul(pEntry->d_name+4, NULL, 10));
+			break;
+		}
+	}
+	closedir(pDir);
+	return dNode;
+}
+#endif
+
 
 LowWeightSearch::LowWeightSearch()
-  : m_pCheckFunction(NULL) {
+  : m_bDeltaPending(false), m_bGaussTracking(false), m_pSystematicForm(NULL), m_pBoard(NULL), m_dBoardWorker(0),
+    m_pCheckFunction(NULL) {
 	
 }
 
@@ -35,319 +110,853 @@ LowWeightSearch::~LowWeightSearch() {
 
 CodeWord
 LowWeightSearch::CanteautChabaud(CodeMatrix oGenerator, Parameters  & oParameters) {
+	CanteautChabaudEngine oEngine;
+	return Search(std::move(oGenerator), oParameters, oEngine);
+}
 
-	CodeMatrix   oZ, oZ1,oZ2;
-	std::vector<uint64_t> vI1, vI2, vSigma;
-	std::vector<uint64_t> vRandPerm, vGaussPerm, vColsPerm;
-	std::vector<uint64_t> vMinimum;
-	CodeWord  oReturn;
-	CodeWord  oTempReturn;
-	CodeWord  oTempWord;
+CodeWord
+LowWeightSearch::Search(CodeMatrix oGenerator, Parameters & oParameters) {
+	IsdEngine * pEngine = CreateEngine(oParameters);
+	if(pEngine == NULL)
+		return CodeWord();
+
+	CodeWord oReturn = Search(std::move(oGenerator), oParameters, *pEngine);
+	delete pEngine;
+	return oReturn;
+}
+
+CodeWord
+LowWeightSearch::Search(CodeMatrix oGenerator, Parameters & oParameters, IsdEngine & oEngine) {
+	return RunSearch(oGenerator, false, oParameters, oEngine);
+}
+
+CodeWord
+LowWeightSearch::SearchCheck(CodeMatrix oCheck, Parameters & oParameters) {
+	IsdEngine * pEngine = CreateEngine(oParameters);
+	if(pEngine == NULL)
+		return CodeWord();
+
+	CodeWord oReturn = SearchCheck(std::move(oCheck), oParameters, *pEngine);
+	delete pEngine;
+	return oReturn;
+}
+
+CodeWord
+LowWeightSearch::SearchCheck(CodeMatrix oCheck, Parameters & oParameters, IsdEngine & oEngine) {
+	return RunSearch(oCheck, true, oParameters, oEngine);
+}
+
+IsdEngine *
+LowWeightSearch::CreateEngine(Parameters & oParameters) {
+	std::string sAlgorithm = oParameters.GetStringParameter(Parameters::ALGORITHM);
+	if(sAlgorithm == "")
+		sAlgorithm = "cc";
+
+	IsdEngine * pEngine = IsdEngine::Create(sAlgorithm);
+	if(pEngine == NULL)
+		std::cout << "Error: Unknown algorithm " << sAlgorithm << "." << std::endl;
+	return pEngine;
+}
 
-	uint64_t dMaxTableSize		  = 1 << oParameters.GetIntegerParameter(Parameters::SIGMA);
-	HashTableRecord** aHashTable  = new HashTableRecord*[dMaxTableSize];
-	HashTableRecord * pTempRecord = NULL;
-	uint64_t dTempCombination     = 0;
-	uint64_t dTempHW              = 0;
-	uint64_t dMinWeight           = 1000000;
-	uint64_t dIterations          = 0;
-	uint64_t i = 0, j = 0;
+CodeWord
+LowWeightSearch::RunSearch(CodeMatrix & oMatrix, bool bCheckMatrix, Parameters & oParameters, IsdEngine & oEngine) {
+
+	CodeMatrix   oZ;
+	SearchState  oState;
+	std::vector<uint64_t>      vColsPerm;
+	std::vector<SearchChain*> & vChains = oState.vChains;
+	std::vector<std::thread>   vThreads;
+	std::vector<ChainSnapshot> vSnapshots;
+	RandomNumberGenerator      oStreams;
+	CodeWord  oReturn;
 
-	bool bMinWeightChanged = false;
-	bool bCheckFunctionResult = true;
+	std::string sResume    = oParameters.GetStringParameter(Parameters::RESUME);
+	uint64_t dThreads      = oParameters.GetIntegerParameter(Parameters::THREADS);
+	uint64_t dMinWeight    = 1000000;
+	uint64_t dMinimumChain = 0;
+	uint64_t i = 0;
 
-	memset(aHashTable, NULL, dMaxTableSize * sizeof(HashTableRecord*));
+	// the code of an r x n check matrix has dimension n-r
+	uint64_t dLength    = oMatrix.GetColumns();
+	uint64_t dDimension = oMatrix.GetRows();
+	if(bCheckMatrix)
+		dDimension = dLength > oMatrix.GetRows() ? dLength-oMatrix.GetRows() : 0;
 
 	m_oOutputFile.SetParameters(oParameters);
-	m_oOutputFile.Write(oParameters.GetStringParameter(Parameters::OUTPUT));
-	CreateGaussMatrix(oGenerator.GetRows());
+	m_oOutputFile.SetBinary(oParameters.GetIntegerParameter(Parameters::BINARYCW) != 0);
+	// the coordinator of a board writes the code words of all workers
+	if(m_pBoard == NULL)
+		m_oOutputFile.Write(oParameters.GetStringParameter(Parameters::OUTPUT));
+	m_oGaussCombinations = CodeMatrix();
+	m_oDeltaZ            = CodeMatrix();
+	m_vDeltaPerm.clear();
+	m_bDeltaPending      = false;
 
 	oParameters.Print();
-	std::cout << "Info: Dimension = " << oGenerator.GetRows() << ", length = " << oGenerator.GetColumns() << std::endl;
+	std::cout << "Info: Dimension = " << dDimension << ", length = " << dLength << std::endl;
 		
-	if( oGenerator.GetRows() == 0 || oGenerator.GetColumns() == 0 ) {
+	if( dDimension == 0 || dLength == 0 ) {
 		std::cout << "Error: Code length and/or dimension is zero." << std::endl;
 		return oReturn;
 	}
 
-	if( !CheckParameters(oParameters) )
-		return oReturn; // return empty code word
-
-	// Prepare permutation vector
-	for(i = 0; i < oGenerator.GetColumns(); i++)
-			vColsPerm.push_back( i );
+	if( dDimension > IsdEngine::MAXROWS ) {
+		std::cout << "Error: The dimension is too large. The value should not exceed " << IsdEngine::MAXROWS << "." << std::endl;
+		return oReturn;
+	}
 
-	if( oParameters.GetIntegerParameter(Parameters::PERMUTE) ) {
-		vRandPerm  = RandomPermuteColumns(oGenerator);
+	if( dLength <= dDimension ) {
+		std::cout << "Error: The code has no redundancy, the length has to be larger than the dimension." << std::endl;
+		return oReturn;
 	}
 
-	if(oGenerator.IsSystematic())
-		std::cout << "Info: Generator matrix is systematic" << std::endl;
-	else {
-		std::cout << "Info: Generator matrix is not systematic" << std::endl;
-		vGaussPerm = GaussMod2(oGenerator);
+	if( !CheckParameters(oParameters) || !oEngine.SetParameters(oParameters) )
+		return oReturn; // return empty code word
+	// the window is a subset of the columns of Z
+	oEngine.LimitSigma(dLength-dDimension);
+
+	if( m_vWeights.size() > 0 && m_vWeights.size() != dLength ) {
+		std::cout << "Error: The weight vector has length " << m_vWeights.size()
+		          << " but the code has length " << dLength << "." << std::endl;
+		return oReturn;
 	}
+	std::cout << "Info: Algorithm = " << oEngine.GetName() << std::endl;
+
+	// the chains must not access oParameters
+	oState.dMaxIterations = oParameters.GetIntegerParameter(Parameters::ITER);
+	oState.dMinimum       = oParameters.GetIntegerParameter(Parameters::MINIMUM);
+	oState.bOutput        = oParameters.GetIntegerParameter(Parameters::DOUTPUT) == 0;
+	oState.bPin           = oParameters.GetIntegerParameter(Parameters::PIN) != 0;
+	oState.dMinWeight     = dMinWeight;
+	oState.dMinimumWeight = dMinWeight;
+	oState.dIterations    = 0;
+	oState.bStop          = false;
+	oState.pMinimumChain  = NULL;
+
+	oState.sCheckpoint     = oParameters.GetStringParameter(Parameters::CHECKPOINT);
+	oState.dCheckpointTime = oParameters.GetIntegerParameter(Parameters::CHECKPOINTTIME);
+	oState.tCheckpoint     = std::chrono::steady_clock::now() + std::chrono::seconds(oState.dCheckpointTime);
+	oState.dGeneration     = 0;
+	oState.dSaved          = 0;
+	oState.bPending        = false;
+
+	std::string sStatistics = oParameters.GetStringParameter(Parameters::STATISTICS);
+	oState.dStatisticsTime  = oParameters.GetIntegerParameter(Parameters::STATISTICSTIME);
+	oState.tStatistics      = std::chrono::steady_clock::now() + std::chrono::seconds(oState.dStatisticsTime);
+	oState.bCsv             = sStatistics.size() >= 4 && sStatistics.compare(sStatistics.size()-4, 4, ".csv") == 0;
+	if(sStatistics != "") {
+		oState.oStatisticsFile.open(sStatistics.c_str(), std::ios::out | std::ios::app);
+		if(oState.oStatisticsFile.fail()) {
+			std::cout << "Error: Can not open file " << sStatistics << "." << std::endl;
+			return oReturn;
+		}
+		if(oState.bCsv && oState.oStatisticsFile.tellp() == 0)
+			SearchStatistics::WriteCsvHeader(oState.oStatisticsFile);
+	}
+	m_oStatistics.Clear();
+	// the identity is only needed if the combinations are recorded
+	if(m_bGaussTracking && sResume == "")
+		CreateGaussMatrix(dDimension);
+
+	if(sResume != "") {
+		// the Gauss setup is skipped, the chains continue from the checkpoint
+		if( !ReadCheckpoint(sResume, dDimension, dLength, oState, vSnapshots, dMinimumChain) )
+			return oReturn;
+		// the chains are restored as they were saved
+		if(dThreads != 0 && dThreads != vSnapshots.size())
+			std::cout << "Warning: The checkpoint has " << vSnapshots.size() << " search chains, "
+			          << "the " << dThreads << " threads of " << Parameters::THREADS << " are ignored." << std::endl;
+		dThreads = vSnapshots.size();
+		std::cout << "Info: Resuming " << dThreads << " search chains from " << sResume
+		          << " after " << oState.dIterations << " iterations" << std::endl;
+		if(oState.oMinimum.GetLength() > 0)
+			PublishMinimum(oState.oMinimum, oState.dMinimumWeight);
+	}
+	else {
+		// the chains jump from the same seed, see RandomNumberGenerator::jump
+		uint64_t dSeed = oParameters.GetIntegerParameter(Parameters::SEED);
+		if(dSeed == 0)
+			dSeed = oStreams.getSeed();
+		std::cout << "Info: Seed = " << dSeed << std::endl;
+		m_oRnGen.setSeed(dSeed);
+		oStreams.setSeed(dSeed);
+
+		// Prepare permutation vector
+		for(i = 0; i < dLength; i++)
+				vColsPerm.push_back( i );
+
+		if( oParameters.GetIntegerParameter(Parameters::PERMUTE) ) {
+			oState.vRandPerm = RandomPermuteColumns(oMatrix);
+		}
+
+		if( bCheckMatrix ) {
+			// Z is the transposed redundancy part of the systematic check matrix
+			std::cout << "Info: Computing the systematic check matrix" << std::endl;
+			if( !CheckSystematicForm(oMatrix, oZ, oState.vGaussPerm) )
+				return oReturn;
+		}
+		else {
+			if( m_pSystematicForm != NULL && oState.vRandPerm.size() == 0 &&
+			    m_pSystematicForm->oGenerator.GetRows() == oMatrix.GetRows() &&
+			    m_pSystematicForm->oGenerator.GetColumns() == oMatrix.GetColumns() &&
+			    (!m_bGaussTracking || m_pSystematicForm->oGaussCombinations.GetRows() == oMatrix.GetRows()) ) {
+				std::cout << "Info: Using the precomputed systematic generator matrix" << std::endl;
+				oMatrix           = m_pSystematicForm->oGenerator;
+				oState.vGaussPerm = m_pSystematicForm->vGaussPerm;
+				if(m_bGaussTracking)
+					m_oGaussCombinations = m_pSystematicForm->oGaussCombinations;
+			}
+			else if(oMatrix.IsSystematic())
+				std::cout << "Info: Generator matrix is systematic" << std::endl;
+			else {
+				std::cout << "Info: Generator matrix is not systematic" << std::endl;
+				oState.vGaussPerm = GaussMod2(oMatrix);
+			}
 
+			// Extract Z
+			std::vector<uint64_t> vRowsZ,vColsZ;
+			for(i = 0; i < oMatrix.GetRows(); i++)
+				vRowsZ.push_back( i );
+			for(i = oMatrix.GetRows(); i < oMatrix.GetColumns(); i++)
+				vColsZ.push_back( i );
 
-	// Extract Z
-	std::vector<uint64_t> vRowsZ,vColsZ;
-	for(i = 0; i < oGenerator.GetRows(); i++)
-		vRowsZ.push_back( i );
-	for(i = oGenerator.GetRows(); i < oGenerator.GetColumns(); i++)
-		vColsZ.push_back( i );
+			oZ = oMatrix.GetSubMatrix(vRowsZ,vColsZ);
+		}
 
-	oZ = oGenerator.GetSubMatrix(vRowsZ,vColsZ);
-	
-	for(i = 0; i < floor(oGenerator.GetRows()/2.0); i++) {
-		vI1.push_back(i);
-		vI2.push_back(static_cast<uint64_t>(floor(oGenerator.GetRows()/2.0)+i));
+		if(dThreads == 0)
+			dThreads = std::thread::hardware_concurrency();
+		if(dThreads == 0)
+			dThreads = 1;
+	}
+	if(dThreads > 1)
+		std::cout << "Info: Running " << dThreads << " search chains" << std::endl;
+	oState.vFinalPerm = ComposePermutations(oState.vGaussPerm, oState.vRandPerm, dLength);
+
+	std::vector<uint32_t> vCpus;
+	if(oState.bPin) {
+		vCpus = GetCpus();
+		if(vCpus.size() > 0)
+			std::cout << "Info: Pinning the search chains to " << std::min<uint64_t>(dThreads, vCpus.size())
+			          << " cores" << std::endl;
+		else
+			std::cout << "Warning: The cores are unknown, the search chains are not pinned" << std::endl;
+	}
+
+	// every chain starts from the same systematic generator matrix
+	// or from its state in the checkpoint, Z is copied by the thread
+	// of the chain (see InitChain)
+	for(i = 0; i < dThreads; i++) {
+		SearchChain * pChain = new SearchChain;
+		if(sResume != "") {
+			pChain->pInitialZ = &vSnapshots[i].oZ;
+			pChain->vColsPerm = vSnapshots[i].vColsPerm;
+			pChain->oRnGen.setState(vSnapshots[i].aRnGen);
+			pChain->dDone     = vSnapshots[i].dDone;
+		}
+		else {
+			oStreams.jump();
+			pChain->pInitialZ = &oZ;
+			pChain->vColsPerm = vColsPerm;
+			pChain->oRnGen    = oStreams;
+			pChain->dDone     = 0;
+		}
+		pChain->pEngine     = oEngine.Clone();
+		pChain->dGeneration = 0;
+		pChain->dCpu        = vCpus.size() > 0 ? vCpus[i % vCpus.size()] : SearchChain::NOCPU;
+		vChains.push_back(pChain);
 	}
+	if(dMinimumChain < vChains.size())
+		oState.pMinimumChain = vChains[dMinimumChain];
 	
+	if(m_pBoard != NULL) {
+		m_dBoardWorker = m_pBoard->Join();
+		if(m_dBoardWorker == SharedBoard::MAXWORKERS) {
+			for(i = 0; i < dThreads; i++) {
+				delete vChains[i]->pEngine;
+				delete vChains[i];
+			}
+			return oReturn;
+		}
+		std::cout << "Info: Joined the board as worker " << m_dBoardWorker << std::endl;
+		SyncBoard(oState);
+	}
+
 	std::cout << std::endl << "iteration" << "\t" << "current minimum" << "\t" << std::endl;
-	while(dIterations < oParameters.GetIntegerParameter(Parameters::ITER)) {
+	oState.dStart = SearchStatistics::Now();
+	// a pinned chain runs in its own thread, the main thread is not pinned
+	if(dThreads == 1 && vChains[0]->dCpu == SearchChain::NOCPU)
+		RunChain(*vChains[0], oState);
+	else {
+		for(i = 0; i < dThreads; i++)
+			vThreads.push_back(std::thread(&LowWeightSearch::RunChain, this,
+			                               std::ref(*vChains[i]), std::ref(oState)));
+		for(i = 0; i < dThreads; i++)
+			vThreads[i].join();
+	}
+	vSnapshots.clear();
+
+	// the final state, a resumed search continues if Parameters::ITER is increased
+	if(oState.sCheckpoint != "") {
+		for(i = 0; i < dThreads; i++)
+			SaveChain(*vChains[i]);
+		SaveMinimum(oState);
+		WriteCheckpoint(oState);
+	}
 
-		vSigma.clear();
-		
-		// select sigma subset
-		vSigma = m_oRnGen.getRandomPosVector(0, oZ.GetColumns()-1,oParameters.GetIntegerParameter(Parameters::SIGMA));
-		
-		// build Z1 and Z2
-		oZ1 = oZ.GetSubMatrix(vI1,vSigma);
-		oZ2 = oZ.GetSubMatrix(vI2,vSigma);
-	
-		// compute hash table for p=2, Z1
-		for(i = 0; i< oZ1.GetRows()-1; i++) {
-			// NOTE: CodeMatrix has < sigma columns, which is max 30
-			dTempCombination = oZ1.At64(i,0);
+	m_oStatistics = oState.oStatistics;
+	if(m_pBoard != NULL) {
+		SyncBoard(oState);
+		m_pBoard->Leave(m_dBoardWorker);
+	}
+	if(oState.oStatisticsFile.is_open())
+		WriteStatistics(oState);
+	if(oState.bOutput)
+		m_oStatistics.Print(static_cast<double>(SearchStatistics::Now()-oState.dStart)*1e-9);
+
+	oReturn    = oState.oMinimum;
+	dMinWeight = oState.dMinWeight;
+	// the Gauss combinations are computed from Z if they are requested,
+	// the chains are deleted below, hence Z is moved
+	SearchChain * pLast = oState.pMinimumChain != NULL ? oState.pMinimumChain : vChains[0];
+	m_oDeltaZ       = std::move(pLast->oZ);
+	m_vDeltaPerm    = std::move(pLast->vColsPerm);
+	m_bDeltaPending = m_oGaussCombinations.GetRows() > 0;
+
+	for(i = 0; i < dThreads; i++) {
+		delete vChains[i]->pEngine;
+		delete vChains[i];
+	}
+
+	// if not one match was found return minimum row of the systematic
+	// generator matrix, the identity part has one bit
+	if( oReturn.GetLength() == 0 ) {
+		std::vector<uint64_t> vRow(1);
+		for(i = 0; i < m_oDeltaZ.GetRows(); i++)
+			if(m_oDeltaZ[i].GetHammingWeight()+1 < dMinWeight) {
+				vRow[0]    = i;
+				oReturn    = BuildMinVector(vRow, m_oDeltaZ, m_vDeltaPerm, oState.vFinalPerm);
+				dMinWeight = oReturn.GetHammingWeight();
+				PublishMinimum(oReturn, dMinWeight);
+			}
+	}
+	if(!m_bDeltaPending) {
+		m_oDeltaZ = CodeMatrix();
+		m_vDeltaPerm.clear();
+	}
+	m_oOutputFile.Flush();
+	return oReturn;
+}
 
-			pTempRecord = new HashTableRecord;
-			pTempRecord->dRow1 = i;
-			pTempRecord->dRow2 = 0;
-			pTempRecord->dRows = 1;
-			pTempRecord->pNextRecord = aHashTable[dTempCombination];
-			aHashTable[dTempCombination] = pTempRecord;
+void
+LowWeightSearch::RunChain(SearchChain & oChain, SearchState & oState) {
 
-			for(j = i+1; j< oZ1.GetRows(); j++) {
+	ChainCallback oCallback(*this, oChain, oState);
+	uint64_t dIteration = 0;
+	bool     bWrite     = false;
+	std::chrono::steady_clock::time_point tSync = std::chrono::steady_clock::now() +
+	                                              std::chrono::milliseconds(SYNCINTERVAL);
 
-				dTempCombination = oZ1.At64(i,0) ^ oZ1.At64(j,0);
+	InitChain(oChain, oState);
 
-				pTempRecord = new HashTableRecord;
-				pTempRecord->dRow1 = i;
-				pTempRecord->dRow2 = j;
-				pTempRecord->dRows = 2;
-				pTempRecord->pNextRecord = aHashTable[dTempCombination];
-				aHashTable[dTempCombination] = pTempRecord;
+	while(!oState.bStop) {
 
-			}
-		}
+		// claim the next iteration
+		dIteration = oState.dIterations++;
+		if(dIteration >= oState.dMaxIterations)
+			break;
+
+		// collision search on a random window
+		oChain.pEngine->Iterate(oChain.oZ, oChain.oRnGen, oCallback);
 		
-		// compare Z1 and Z2 online
-		for(i = 0; i< oZ2.GetRows()-1; i++)
-		{
-			dTempCombination = oZ2.At64(i,0);
-
-			// check if value is in table
-			if( aHashTable[dTempCombination] != NULL) {
-				pTempRecord = aHashTable[dTempCombination];
-
-				// compute HW
-				oTempWord  = oZ[vI2[i]];
-				oTempWord ^= oZ[vI1[pTempRecord->dRow1]];
-				if( pTempRecord->dRows == 2)
-					oTempWord ^= oZ[vI1[pTempRecord->dRow2]];
-					
-				if( m_vWeights.size() == 0 )
-					dTempHW = oTempWord.GetHammingWeight();
-				else
-					dTempHW = oTempWord.GetHammingWeight(m_vWeights);
-					
-				dTempHW += pTempRecord->dRows + 1;
-
-				if( dTempHW < dMinWeight ) {
-
-					bMinWeightChanged = true;
-					vMinimum.clear();
-					vMinimum.push_back(vI1[pTempRecord->dRow1]);
-					if( pTempRecord->dRows == 2)
-						vMinimum.push_back(vI1[pTempRecord->dRow2]);
-					vMinimum.push_back(vI2[i]);
-
-					oTempReturn = BuildMinVector(vMinimum,oZ,vColsPerm, vGaussPerm, vRandPerm);
-					if(m_pCheckFunction != NULL)
-						bCheckFunctionResult = m_pCheckFunction(oTempReturn);
-
-					if(bCheckFunctionResult) {
-						m_vCombinedRows = vMinimum;
-						dMinWeight = dTempHW;
-						oReturn = oTempReturn;
-						m_oOutputFile.WriteCodeWord(oReturn);
-						// stop the search if given minimum is reached
-						if(dMinWeight <= oParameters.GetIntegerParameter(Parameters::MINIMUM)) {
-							FreeHashTable(aHashTable,dMaxTableSize);
-							return oReturn;
-						}
-					}
-				}
-			}
-			
-
-			for(j = i+1; j< oZ2.GetRows(); j++) {
-				dTempCombination = oZ2.At64(i,0) ^ oZ2.At64(j,0);
-
-				if( aHashTable[dTempCombination] != NULL) {
-					pTempRecord = aHashTable[dTempCombination];
-					// compute HW
-					oTempWord  = oZ[vI2[i]] ^ oZ[vI2[j]] ^ oZ[vI1[pTempRecord->dRow1]];
-					if( pTempRecord->dRows == 2)
-						oTempWord ^= oZ[vI1[pTempRecord->dRow2]];
-					
-					if( m_vWeights.size() == 0 )
-						dTempHW = oTempWord.GetHammingWeight();
-					else
-						dTempHW = oTempWord.GetHammingWeight(m_vWeights);
-					dTempHW += pTempRecord->dRows + 2;
-
-					if( dTempHW < dMinWeight ) {
-
-						bMinWeightChanged = true;
-						vMinimum.clear();
-						vMinimum.push_back(vI1[pTempRecord->dRow1]);
-						if( pTempRecord->dRows == 2)
-							vMinimum.push_back(vI1[pTempRecord->dRow2]);
-						vMinimum.push_back(vI2[i]);
-						vMinimum.push_back(vI2[j]);
-
-						oTempReturn = BuildMinVector(vMinimum,oZ,vColsPerm, vGaussPerm, vRandPerm);
-
-						if(m_pCheckFunction != NULL)
-							bCheckFunctionResult = m_pCheckFunction(oTempReturn);
-
-						if(bCheckFunctionResult) {
-							m_vCombinedRows = vMinimum;
-							dMinWeight = dTempHW;
-							oReturn = oTempReturn;
-							m_oOutputFile.WriteCodeWord(oReturn);
-
-							if(dMinWeight <= oParameters.GetIntegerParameter(Parameters::MINIMUM)) {
-								FreeHashTable(aHashTable,dMaxTableSize);
-								return oReturn;
-							}
-						}
-					}
-				}
-			}
+		// keep the matrix which produced the minimum if the search stops
+		if(!oState.bStop) {
+			uint64_t dStart = SearchStatistics::Now();
+			DeltaGauss(oChain);
+			oChain.oStatistics.dDeltaGaussTime += SearchStatistics::Now()-dStart;
 		}
-		
-		DeltaGauss(oZ,vColsPerm);
-		FreeHashTable(aHashTable,dMaxTableSize);
-		
-
-		if ( oParameters.GetIntegerParameter(Parameters::DOUTPUT) == 0 && bMinWeightChanged) {
-			std::cout << dIterations  << "\t\t" << dMinWeight << "\t\t" << std::endl;
+		oChain.oStatistics.dIterations++;
+		oChain.dDone++;
+
+		// the shared state is only updated at intervals or if the minimum
+		// changed, thus the chains rarely wait for the mutex
+		std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+		if(oCallback.m_bMinWeightChanged || tNow >= tSync) {
+			std::lock_guard<std::mutex> oLock(oState.oMutex);
+			if ( oState.bOutput && oCallback.m_bMinWeightChanged)
+				std::cout << dIteration  << "\t\t" << oState.dMinWeight << "\t\t" << std::endl;
+			// buffered code words are written even if the minimum does not change
+			m_oOutputFile.FlushIfDue();
+
+			CollectStatistics(oChain, oState);
+			if(m_pBoard != NULL)
+				SyncBoard(oState);
+			if(oState.sCheckpoint != "")
+				bWrite = Checkpoint(oChain, oState);
+		}
+		oCallback.m_bMinWeightChanged = false;
+		if(tNow >= tSync)
+			tSync = tNow + std::chrono::milliseconds(SYNCINTERVAL);
+
+		// the file is written without blocking the other chains
+		if(bWrite) {
+			FinishCheckpoint(oState);
+			bWrite = false;
 		}
-		bMinWeightChanged = false;
-		dIterations++;
 
-		if(dMinWeight == 0)
-			break;
+		if(oState.dMinWeight == 0)
+			oState.bStop = true;
 	}
 
-	// if not one match was found return minimum row of the code matrix
-	if( oReturn.GetLength() == 0 ) {
-		for(i = 0; i < oGenerator.GetRows(); i++)
-			if(oGenerator[i].GetHammingWeight() < dMinWeight) {
-				dMinWeight = oGenerator[i].GetHammingWeight(); 
-				oReturn = oGenerator[i];
-				m_oOutputFile.WriteCodeWord(oReturn);
-			}
+	// the remaining statistics of the chain
+	std::lock_guard<std::mutex> oLock(oState.oMutex);
+	CollectStatistics(oChain, oState);
+}
+
+LowWeightSearch::ChainCallback::ChainCallback(LowWeightSearch & oSearch, SearchChain & oChain,
+                                              SearchState & oState)
+  : m_bMinWeightChanged(false), m_oSearch(oSearch), m_oChain(oChain), m_oState(oState) {
+}
+
+bool
+LowWeightSearch::ChainCallback::IsStopped() {
+	return m_oState.bStop;
+}
+
+void
+LowWeightSearch::ChainCallback::Candidate(const uint64_t * pRows, uint32_t dRows) {
+	uint64_t dMinWeight = m_oState.dMinWeight;
+	uint64_t dWeight    = 0;
+
+	// the clock is expensive compared to a candidate, only a sample is timed
+	if((m_oChain.oStatistics.dCandidates++ & (SearchStatistics::SAMPLE-1)) == 0) {
+		uint64_t dStart = SearchStatistics::Now();
+		dWeight = m_oSearch.CandidateWeight(m_oChain, pRows, dRows, dMinWeight);
+		m_oChain.oStatistics.dCandidateTime += (SearchStatistics::Now()-dStart)*SearchStatistics::SAMPLE;
 	}
-	FreeHashTable(aHashTable,dMaxTableSize);
-	delete[] aHashTable;
-	return oReturn;
+	else
+		dWeight = m_oSearch.CandidateWeight(m_oChain, pRows, dRows, dMinWeight);
+
+	if( dWeight >= dMinWeight )
+		m_oChain.oStatistics.dEarlyAborts++;
+	else {
+		m_vMinimum.assign(pRows, pRows+dRows);
+		if(m_oSearch.UpdateMinimum(m_oChain, m_oState, m_vMinimum, dWeight))
+			m_bMinWeightChanged = true;
+	}
+}
+
+uint64_t
+LowWeightSearch::CandidateWeight(const SearchChain & oChain, const uint64_t * pRows, uint32_t dRows,
+                                 uint64_t dMinWeight) const {
+	// the candidate has dRows ones in the identity part, counting stops
+	// as soon as the candidate can not be a new minimum
+	if( oChain.vRowWeights.size() == 0 ) {
+		uint64_t dBound = dMinWeight > dRows ? dMinWeight-dRows : 0;
+		return oChain.oZ.XorWeight(pRows, dRows, dBound) + dRows;
+	}
+
+	uint64_t dIdentity = 0;
+	for(uint32_t i = 0; i < dRows; i++)
+		dIdentity += oChain.vRowWeights[pRows[i]];
+	if( dIdentity >= dMinWeight )
+		return dIdentity;
+	return oChain.oZ.XorWeight(pRows, dRows, oChain.oWeights, dMinWeight-dIdentity) + dIdentity;
 }
 
 void
-LowWeightSearch::DeltaGauss(CodeMatrix & oZ, std::vector<uint64_t> & vColsPerm) {
+LowWeightSearch::InitChain(SearchChain & oChain, SearchState & oState) {
+
+	if(oChain.dCpu != SearchChain::NOCPU && !PinThread(oChain.dCpu)) {
+		std::lock_guard<std::mutex> oLock(oState.oMutex);
+		std::cout << "Warning: Could not pin a search chain to core " << oChain.dCpu << std::endl;
+	}
+
+	// first touch of the pages of the chain
+	oChain.oZ = *oChain.pInitialZ;
+	oChain.pInitialZ = NULL;
+	if( m_vWeights.size() > 0 )
+		InitWeights(oChain, oState.vFinalPerm);
+}
+
+std::vector<uint32_t>
+LowWeightSearch::GetCpus() {
+	std::vector<uint32_t> vCpus;
+#ifdef __linux__
+	cpu_set_t oSet;
+	CPU_ZERO(&oSet);
+	if(sched_getaffinity(0, sizeof(oSet), &oSet) != 0)
+		return vCpus;
+
+	// the cores of each node
+	std::map<uint32_t, std::vector<uint32_t> > mNodes;
+	for(uint32_t dCpu = 0; dCpu < CPU_SETSIZE; dCpu++)
+		if(CPU_ISSET(dCpu, &oSet))
+			mNodes[CpuNode(dCpu)].push_back(dCpu);
+
+	// round-robin over the nodes
+	for(uint64_t i = 0; vCpus.size() < static_cast<uint64_t>(CPU_COUNT(&oSet)); i++)
+		for(std::map<uint32_t, std::vector<uint32_t> >::iterator it = mNodes.begin(); it != mNodes.end(); ++it)
+			if(i < it->second.size())
+				vCpus.push_back(it->second[i]);
+#endif
+	return vCpus;
+}
+
+bool
+LowWeightSearch::PinThread(uint32_t dCpu) {
+#ifdef __linux__
+	cpu_set_t oSet;
+	CPU_ZERO(&oSet);
+	CPU_SET(dCpu, &oSet);
+	return pthread_setaffinity_np(pthread_self(), sizeof(oSet), &oSet) == 0;
+#else
+	(void)dCpu;
+	return false;
+#endif
+}
+
+void
+LowWeightSearch::InitWeights(SearchChain & oChain, const std::vector<uint64_t> & vFinalPerm) const {
+	uint64_t dRows = oChain.oZ.GetRows();
+	std::vector<uint64_t> vZWeights(oChain.oZ.GetColumns());
+
+	oChain.vRowWeights.resize(dRows);
+	for(uint64_t i = 0; i < dRows; i++)
+		oChain.vRowWeights[i] = m_vWeights[vFinalPerm[oChain.vColsPerm[i]]];
+	for(uint64_t i = 0; i < vZWeights.size(); i++)
+		vZWeights[i] = m_vWeights[vFinalPerm[oChain.vColsPerm[dRows+i]]];
+	oChain.oWeights.SetWeights(vZWeights);
+}
+
+bool
+LowWeightSearch::UpdateMinimum(SearchChain & oChain, SearchState & oState,
+                               std::vector<uint64_t> & vMinimum, uint64_t dWeight) {
+
+	uint64_t dStart    = SearchStatistics::Now();
+	CodeWord oCodeWord = BuildMinVector(vMinimum, oChain.oZ, oChain.vColsPerm, oState.vFinalPerm);
+	oChain.oStatistics.dBuildTime += SearchStatistics::Now()-dStart;
+
+	if(m_pCheckFunction != NULL && !m_pCheckFunction(oCodeWord))
+		return false;
+
+	std::lock_guard<std::mutex> oLock(oState.oMutex);
+
+	// another chain may have found a better code word in the meantime
+	if(dWeight >= oState.dMinWeight)
+		return false;
+
+	m_vCombinedRows       = vMinimum;
+	oChain.oStatistics.dImprovements++;
+	oState.dMinWeight     = dWeight;
+	oState.dMinimumWeight = dWeight;
+	oState.oMinimum       = oCodeWord;
+	oState.pMinimumChain  = &oChain;
+	PublishMinimum(oCodeWord, dWeight);
+
+	// stop the search if given minimum is reached
+	if(dWeight <= oState.dMinimum)
+		oState.bStop = true;
+	return true;
+}
+
+void
+LowWeightSearch::DeltaGauss(SearchChain & oChain) {
 	
-	uint64_t lambda = m_oRnGen.getRandomPosInteger(oZ.GetRows());
-	uint64_t mu     = m_oRnGen.getRandomPosInteger(oZ.GetColumns());
+	CodeMatrix & oZ = oChain.oZ;
+	uint64_t lambda = oChain.oRnGen.getRandomPosInteger(oZ.GetRows());
+	uint64_t mu     = oChain.oRnGen.getRandomPosInteger(oZ.GetColumns());
 	uint64_t dIsOne = oZ.AtBool(lambda,mu);
 
 	while(dIsOne == 0)
 	{
-		lambda = m_oRnGen.getRandomPosInteger(oZ.GetRows());
-		mu     = m_oRnGen.getRandomPosInteger(oZ.GetColumns());
+		lambda = oChain.oRnGen.getRandomPosInteger(oZ.GetRows());
+		mu     = oChain.oRnGen.getRandomPosInteger(oZ.GetColumns());
 		dIsOne = oZ.AtBool(lambda,mu);
 	}
 	
-	for(uint64_t i = 0; i < oZ.GetRows(); i++) {
+	// adds row lambda to all rows with a one in column mu, in place
+	oZ.Pivot(lambda, mu, oChain.vColumn);
+
+	uint64_t temp = oChain.vColsPerm[lambda];
+	oChain.vColsPerm[lambda] = oChain.vColsPerm[mu+oZ.GetRows()];
+	oChain.vColsPerm[mu+oZ.GetRows()] = temp;
+
+	// the weights are swapped with the columns
+	if( oChain.vRowWeights.size() > 0 ) {
+		temp = oChain.vRowWeights[lambda];
+		oChain.vRowWeights[lambda] = oChain.oWeights.GetWeight(mu);
+		oChain.oWeights.SetWeight(mu, temp);
+	}
+}
 
-		dIsOne = oZ.AtBool(i,mu);
-		if(dIsOne > 0 && i != lambda) {
-			CodeWord oTemp = oZ[i] ^ oZ[lambda];
-			bool bTemp = oZ.AtBool(i,mu);
-			
-			oZ[i] = oTemp;
-			oZ.SetBool(i,mu,bTemp);
+void
+LowWeightSearch::CollectStatistics(SearchChain & oChain, SearchState & oState) {
+	SearchStatistics & oEngine = oChain.pEngine->GetStatistics();
+
+	oState.oStatistics.Add(oChain.oStatistics);
+	oState.oStatistics.Add(oEngine);
+	oChain.oStatistics.Clear();
+	// the memory of the hash table is kept by the engine
+	uint64_t dIndexMemory = oEngine.dIndexMemory;
+	oEngine.Clear();
+	oEngine.dIndexMemory = dIndexMemory;
+
+	if(oState.oStatisticsFile.is_open() && std::chrono::steady_clock::now() >= oState.tStatistics) {
+		WriteStatistics(oState);
+		oState.tStatistics = std::chrono::steady_clock::now() + std::chrono::seconds(oState.dStatisticsTime);
+	}
+}
 
-			m_oGaussCombinations[i] ^= m_oGaussCombinations[lambda];
-		}
+void
+LowWeightSearch::SyncBoard(SearchState & oState) {
+	uint64_t dMinWeight = oState.oMinimum.GetLength() > 0 ? oState.dMinimumWeight : UINT64_MAX;
+	m_pBoard->SetProgress(m_dBoardWorker, oState.oStatistics.dIterations, dMinWeight);
+
+	// candidates which are not better than the minimum of all workers are discarded
+	uint64_t dBest = m_pBoard->GetBestWeight();
+	if(dBest < oState.dMinWeight)
+		oState.dMinWeight = dBest;
+	if(dBest <= oState.dMinimum || m_pBoard->IsStopped())
+		oState.bStop = true;
+}
+
+void
+LowWeightSearch::PublishMinimum(const CodeWord & oCodeWord, uint64_t dWeight) {
+	if(m_pBoard != NULL)
+		m_pBoard->Offer(oCodeWord, dWeight);
+	else
+		m_oOutputFile.WriteCodeWord(oCodeWord);
+}
+
+void
+LowWeightSearch::WriteStatistics(SearchState & oState) {
+	double dSeconds = static_cast<double>(SearchStatistics::Now()-oState.dStart)*1e-9;
+
+	if(oState.bCsv)
+		oState.oStatistics.WriteCsv(oState.oStatisticsFile, dSeconds, oState.dMinWeight);
+	else
+		oState.oStatistics.WriteJson(oState.oStatisticsFile, dSeconds, oState.dMinWeight);
+}
+
+bool
+LowWeightSearch::Checkpoint(SearchChain & oChain, SearchState & oState) {
+	std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+	if(!oState.bPending && tNow >= oState.tCheckpoint) {
+		oState.dGeneration++;
+		oState.dSaved   = 0;
+		oState.bPending = true;
 	}
-	uint64_t temp = vColsPerm[lambda];
-	vColsPerm[lambda] = vColsPerm[mu+oZ.GetRows()];
-	vColsPerm[mu+oZ.GetRows()] = temp;
+	if(!oState.bPending || oChain.dGeneration == oState.dGeneration)
+		return false;
+
+	SaveChain(oChain);
+	oChain.dGeneration = oState.dGeneration;
+	if(++oState.dSaved < oState.vChains.size())
+		return false;
+
+	SaveMinimum(oState);
+	return true;
 }
 
-CodeWord
-LowWeightSearch::BuildMinVector(std::vector<uint64_t> & vMinimum, CodeMatrix & oZ,
-		std::vector<uint64_t> & vColsPerm, std::vector<uint64_t> & vGaussPerm,
-		std::vector<uint64_t> & vRandPerm) {
+void
+LowWeightSearch::FinishCheckpoint(SearchState & oState) {
+	WriteCheckpoint(oState);
 
-	CodeWord oTempWord = oZ[vMinimum[0]], oFront, oReturn;
-	
-	for(uint32_t i=0; i< oZ.GetRows();i++)
-		oFront.PushBool(0);
-	for(uint32_t i=0; i< vMinimum.size();i++)
-		oFront.SetBool(vMinimum[i], 1);
-	
-	for(uint32_t i=1; i< vMinimum.size();i++)
-		oTempWord ^= oZ[vMinimum[i]];
+	// the saved matrices are kept, the next SaveChain copies into their memory
+	std::lock_guard<std::mutex> oLock(oState.oMutex);
+	oState.bPending    = false;
+	oState.tCheckpoint = std::chrono::steady_clock::now() + std::chrono::seconds(oState.dCheckpointTime);
+}
 
-	for(uint32_t i=0; i< oTempWord.GetLength();i++)
-		oFront.PushBool(oTempWord.AtBool(i));
+void
+LowWeightSearch::SaveMinimum(SearchState & oState) {
+	oState.oSavedMinimum = oState.oMinimum;
+	oState.vSavedRows    = m_vCombinedRows;
+	oState.dSavedWeight  = oState.dMinimumWeight;
+	oState.dSavedChain   = oState.vChains.size();
+	for(uint64_t i = 0; i < oState.vChains.size(); i++)
+		if(oState.vChains[i] == oState.pMinimumChain)
+			oState.dSavedChain = i;
+}
 
-	// permute back
-	oReturn = oFront;
+void
+LowWeightSearch::SaveChain(SearchChain & oChain) {
+	oChain.oSaved.oZ        = oChain.oZ;
+	oChain.oSaved.vColsPerm = oChain.vColsPerm;
+	oChain.oRnGen.getState(oChain.oSaved.aRnGen);
+	oChain.oSaved.dDone     = oChain.dDone;
+}
 
-	for(uint32_t j= 0; j< vColsPerm.size() ;j++)
-		oReturn.SetBool(vColsPerm[j], oFront.AtBool(j));
-	
-	oFront = oReturn;
-	for(uint32_t j= 0; j< vGaussPerm.size() ;j++)
-		oReturn.SetBool(vGaussPerm[j], oFront.AtBool(j));
+bool
+LowWeightSearch::WriteCheckpoint(SearchState & oState) {
+	std::string sTemp = oState.sCheckpoint + ".tmp";
+	CheckpointHeader oHeader;
+	CodeMatrix oMinimum;
+	uint64_t i = 0;
+
+	memset(&oHeader, 0, sizeof(oHeader));
+	memcpy(oHeader.aMagic, CHECKPOINTMAGIC, sizeof(oHeader.aMagic));
+	oHeader.dVersion      = CHECKPOINTVERSION;
+	oHeader.dChains       = static_cast<uint32_t>(oState.vChains.size());
+	oHeader.dRows         = oState.vChains[0]->oSaved.oZ.GetRows();
+	oHeader.dColumns      = oState.vChains[0]->oSaved.vColsPerm.size();
+	oHeader.dMinWeight    = oState.dSavedWeight;
+	oHeader.dMinimumChain = oState.dSavedChain;
+	oHeader.dByteOrder    = CHECKPOINTORDER;
+	if(oState.oSavedMinimum.GetLength() > 0)
+		oMinimum.AddRow(oState.oSavedMinimum);
+
+	std::ofstream oFile(sTemp.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	oFile.write(reinterpret_cast<const char*>(&oHeader), sizeof(oHeader));
+	WriteVector(oFile, oState.vGaussPerm);
+	WriteVector(oFile, oState.vRandPerm);
+	WriteVector(oFile, oState.vSavedRows);
+	oMinimum.WriteBinary(oFile);
+	m_oGaussCombinations.WriteBinary(oFile);
+	for(i = 0; i < oState.vChains.size(); i++) {
+		ChainSnapshot & oSaved = oState.vChains[i]->oSaved;
+		oFile.write(reinterpret_cast<const char*>(oSaved.aRnGen), sizeof(oSaved.aRnGen));
+		oFile.write(reinterpret_cast<const char*>(&oSaved.dDone), sizeof(oSaved.dDone));
+		WriteVector(oFile, oSaved.vColsPerm);
+		oSaved.oZ.WriteBinary(oFile);
+	}
+	oFile.close();
+	if(oFile.fail()) {
+		std::cout << "Error: The checkpoint " << sTemp << " can not be written." << std::endl;
+		return false;
+	}
+
+#ifdef LOWWEIGHTSEARCH_FSYNC
+	// the data has to be on the disk before the old checkpoint is replaced
+	int dFile = open(sTemp.c_str(), O_RDONLY);
+	if(dFile >= 0) {
+		fsync(dFile);
+		close(dFile);
+	}
+#else
+	std::remove(oState.sCheckpoint.c_str());
+#endif
+	if(std::rename(sTemp.c_str(), oState.sCheckpoint.c_str()) != 0) {
+		std::cout << "Error: The checkpoint " << oState.sCheckpoint << " can not be written." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool
+LowWeightSearch::ReadCheckpoint(const std::string & sFileName, uint64_t dRows, uint64_t dColumns, SearchState & oState,
+                                std::vector<ChainSnapshot> & vSnapshots, uint64_t & dMinimumChain) {
+	CheckpointHeader oHeader;
+	CodeMatrix oMinimum;
+	bool bRead = true;
+
+	std::ifstream oFile(sFileName.c_str(), std::ios::in | std::ios::binary);
+	if(oFile.fail()) {
+		std::cout << "Error: The file " << sFileName << " does not exist." << std::endl;
+		return false;
+	}
+
+	oFile.read(reinterpret_cast<char*>(&oHeader), sizeof(oHeader));
+	if(oFile.fail() || memcmp(oHeader.aMagic, CHECKPOINTMAGIC, sizeof(oHeader.aMagic)) != 0 ||
+	   oHeader.dVersion != CHECKPOINTVERSION || oHeader.dByteOrder != CHECKPOINTORDER) {
+		std::cout << "Error: The file " << sFileName << " is not a checkpoint." << std::endl;
+		return false;
+	}
+	if(oHeader.dRows != dRows || oHeader.dColumns != dColumns || oHeader.dChains == 0) {
+		std::cout << "Error: The checkpoint " << sFileName << " belongs to another generator matrix." << std::endl;
+		return false;
+	}
+
+	bRead = ReadVector(oFile, oState.vGaussPerm, dColumns) && ReadVector(oFile, oState.vRandPerm, dColumns) &&
+	        ReadVector(oFile, m_vCombinedRows, dRows) && oMinimum.ReadBinary(oFile) &&
+	        m_oGaussCombinations.ReadBinary(oFile) &&
+	        (m_oGaussCombinations.GetRows() == dRows || m_oGaussCombinations.GetRows() == 0);
+
+	vSnapshots.resize(oHeader.dChains);
+	oState.dIterations = 0;
+	for(uint64_t i = 0; i < vSnapshots.size() && bRead; i++) {
+		oFile.read(reinterpret_cast<char*>(vSnapshots[i].aRnGen), sizeof(vSnapshots[i].aRnGen));
+		oFile.read(reinterpret_cast<char*>(&vSnapshots[i].dDone), sizeof(vSnapshots[i].dDone));
+		bRead = !oFile.fail() && ReadVector(oFile, vSnapshots[i].vColsPerm, dColumns) &&
+		        vSnapshots[i].vColsPerm.size() == dColumns && vSnapshots[i].oZ.ReadBinary(oFile) &&
+		        vSnapshots[i].oZ.GetRows() == dRows && vSnapshots[i].oZ.GetColumns() == dColumns-dRows;
+		oState.dIterations += vSnapshots[i].dDone;
+	}
+	if(!bRead) {
+		std::cout << "Error: The checkpoint " << sFileName << " is corrupt." << std::endl;
+		return false;
+	}
+	// the search can continue, but GetGaussCombinations returns an empty matrix
+	if(m_bGaussTracking && m_oGaussCombinations.GetRows() == 0)
+		std::cout << "Warning: The checkpoint " << sFileName << " has no Gauss combinations, "
+		          << "they are not available after the search." << std::endl;
+	if(!m_bGaussTracking)
+		m_oGaussCombinations = CodeMatrix();
+
+	oState.dMinWeight     = oHeader.dMinWeight;
+	oState.dMinimumWeight = oHeader.dMinWeight;
+	if(oMinimum.GetRows() > 0)
+		oState.oMinimum = oMinimum[0];
+	dMinimumChain = oHeader.dMinimumChain;
+	return true;
+}
+
+CodeWord
+LowWeightSearch::BuildMinVector(const std::vector<uint64_t> & vMinimum, CodeMatrix & oZ,
+		const std::vector<uint64_t> & vColsPerm, const std::vector<uint64_t> & vFinalPerm) {
+
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dRows     = oZ.GetRows();
+	uint64_t dLength   = vColsPerm.size();
+	CodeWord oSum = oZ[vMinimum[0]], oReturn;
 
-	oFront = oReturn;
-	for(uint64_t j= 0; j < vRandPerm.size(); j++)
-		oReturn.SetBool(vRandPerm[j], oFront.AtBool(j));
+	for(uint32_t i=1; i< vMinimum.size();i++)
+		oSum ^= oZ[vMinimum[i]];
+
+	for(uint64_t i = 0; i < dLength/dWordSize; i++)
+		oReturn.Push64(0);
+	for(uint64_t i = dLength-dLength%dWordSize; i < dLength; i++)
+		oReturn.PushBool(0);
+
+	// only the ones are moved, column j of the systematic generator
+	// matrix is column vFinalPerm[vColsPerm[j]] of the original one
+	for(uint32_t i=0; i< vMinimum.size();i++)
+		oReturn.SetBool(vFinalPerm[vColsPerm[vMinimum[i]]], 1);
+
+	for(uint64_t w = 0; w < oSum.GetLength64(); w++) {
+		// the last word is right aligned by At64
+		uint64_t dBits = std::min<uint64_t>(dWordSize, oSum.GetLength()-w*dWordSize);
+		for(uint64_t dWord = oSum.At64(w); dWord != 0; dWord &= dWord-1) {
+			uint64_t dColumn = w*dWordSize + dBits-1 - __builtin_ctzll(dWord);
+			oReturn.SetBool(vFinalPerm[vColsPerm[dRows+dColumn]], 1);
+		}
+	}
 
 	return oReturn;
 }
 
+std::vector<uint64_t>
+LowWeightSearch::ComposePermutations(const std::vector<uint64_t> & vGaussPerm,
+                                     const std::vector<uint64_t> & vRandPerm, uint64_t dColumns) {
+	std::vector<uint64_t> vFinalPerm(dColumns);
+
+	// an empty permutation is the identity
+	for(uint64_t j = 0; j < dColumns; j++) {
+		uint64_t k = vGaussPerm.size() > 0 ? vGaussPerm[j] : j;
+		vFinalPerm[j] = vRandPerm.size() > 0 ? vRandPerm[k] : k;
+	}
+	return vFinalPerm;
+}
+
 
 std::vector<uint64_t>
 LowWeightSearch::RandomPermuteColumns(CodeMatrix & oGenerator) {
 
 	std::vector<uint64_t> vPerm;
-	CodeMatrix oTempMatrix = oGenerator;
 
 	vPerm = m_oRnGen.getRandomPosVector(0, oGenerator.GetColumns()-1,oGenerator.GetColumns());
-
-	for(uint64_t i = 0; i < oGenerator.GetColumns(); i++) {
-		for(uint64_t j = 0; j < oGenerator.GetRows(); j++) {
-			oTempMatrix[j].SetBool(i, oGenerator[j].AtBool(vPerm[i]));
-		}
-	}
-	oGenerator = oTempMatrix;
+	oGenerator.PermuteColumns(vPerm);
 	return vPerm;
 
 }
@@ -356,8 +965,8 @@ bool
 LowWeightSearch::CheckParameters(Parameters & oParameters) {
 	bool bError = true;
 
-	if( oParameters.GetIntegerParameter("-s") > 30 ) {
-		std::cout << "Error: sigma is too large. The value should not exceed 30." << std::endl;
+	if( oParameters.GetIntegerParameter(Parameters::SIGMA) > IsdEngine::MAXSIGMA ) {
+		std::cout << "Error: sigma is too large. The value should not exceed " << IsdEngine::MAXSIGMA << "." << std::endl;
 		bError = false;
 	}
 
@@ -368,115 +977,52 @@ LowWeightSearch::CheckParameters(Parameters & oParameters) {
 std::vector<uint64_t>
 LowWeightSearch::GaussMod2(CodeMatrix & oMatrix) {
 	
-	CodeWord oTempRow;
-	std::vector<uint64_t> vColChange;
-	bool bFoundPivot = false;
-	bool bTest = false;
-	uint64_t MSB = 0x8000000000000000;
-	uint16_t dWordSize = sizeof(uint64_t)*8;
+	BlockElimination oElimination;
+	std::vector<uint64_t> vPivots;
 
 	std::cout << "Info: Applying Gauss-Jordan algorithm." << std::endl;
 
-	if( dWordSize == 64 )
-		MSB = 0x8000000000000000;
-	else
-		MSB = 0x80000000;
-
-	for(uint64_t i = 0; i < oMatrix.GetColumns(); i++)
-			vColChange.push_back( i );
-
-	for(uint64_t j = 0; j < oMatrix.GetRows(); j++) {
-
-		bFoundPivot = false;
-		for(uint64_t i = j; i < oMatrix.GetRows(); i++) {
-
-			if( (oMatrix[i].At64(j/dWordSize) << (j%dWordSize)) & MSB ) {
-
-				oTempRow = oMatrix[i];
-				oMatrix[i] = oMatrix[j];
-				oMatrix[j] = oTempRow;
+	// row j becomes the pivot of column j, the same row operations
+	// are recorded in the Gauss combinations if they are enabled
+	for(uint64_t j = 0; j < oMatrix.GetRows() && j < oMatrix.GetColumns(); j++)
+		vPivots.push_back( j );
 
-				bFoundPivot = true;
-				break;
-			}
-		}
-	
-		// swap columns, slow
-		if ( !bFoundPivot ) {
-			bTest = false;
-	    	for(uint64_t k = j; k < oMatrix.GetColumns(); k++) {
-
-	    		if( oMatrix[j].AtBool(k) ) {
-					for(uint64_t l = 0; l < oMatrix.GetRows(); l++) {
-						bool dTemp = oMatrix[l].AtBool(k);
-						oMatrix[l].SetBool(k, oMatrix[l].AtBool(j));
-						oMatrix[l].SetBool(j, dTemp);
-					}
-					uint64_t dTemp2 = vColChange[k];
-					vColChange[k] = vColChange[j];
-					vColChange[j] = dTemp2;
-					bTest = true;
-					break;
-	    		}
-	    	}
-	    	if(bTest == false){
-				std::cout << "Error: Matrix has not full rank." << std::endl;
-	    	}
-		}
-		
-		for(uint64_t i =0; i < oMatrix.GetRows(); i++) {
+	bool bTrack = m_bGaussTracking && m_oGaussCombinations.GetRows() == oMatrix.GetRows();
+	oElimination.Load(oMatrix, bTrack ? &m_oGaussCombinations : NULL);
+	if( oElimination.Eliminate(vPivots, false, true) < oMatrix.GetRows() )
+		std::cout << "Error: Matrix has not full rank." << std::endl;
 
-			if(i==j)
-				continue;
-			if( (oMatrix[i].At64(j/dWordSize) << (j%dWordSize)) & MSB ) {
-				oMatrix[i] ^= oMatrix[j];
-				m_oGaussCombinations[i] ^= m_oGaussCombinations[j];
-			}
-		}
-	}
+	oElimination.GetRows(oMatrix, 0);
+	if(bTrack)
+		oElimination.GetAttached(m_oGaussCombinations);
 
-	return vColChange;
+	return oElimination.GetColumnPermutation();
 }
 
 
 CodeMatrix
 LowWeightSearch::CodeShortening(CodeMatrix & oMatrix, std::vector<uint64_t> & vColumns){
 
-	CodeMatrix oTempMatrix = oMatrix;
+	BlockElimination oElimination;
+	CodeMatrix oTempMatrix;
+	std::vector<bool>     vForced(oMatrix.GetColumns(), false);
+	std::vector<uint64_t> vKeep;
 
-	bool bPivotFound = false;
-	uint64_t dPivotRow = 0;
+	// the first row with a one in a forced column is the pivot, it is
+	// removed after the column was eliminated from all other rows
+	oElimination.Load(oMatrix);
+	uint64_t dRank = oElimination.Eliminate(vColumns, true, false);
 
-	for(unsigned int j = 0; j < vColumns.size(); j++) {
-		bPivotFound = false;
-		for(unsigned int i = 0; i < oTempMatrix.GetRows(); i++) {
-			if(!bPivotFound) {
-				if(oTempMatrix[i].AtBool(vColumns[j]) == 1) {
-					bPivotFound = true;
-					dPivotRow = i;
-					i = 0;
-				}
-			}
-			else {
-				if( i != dPivotRow ) {
-					if(oTempMatrix[i].AtBool(vColumns[j])) {
-						oTempMatrix[i] ^= oTempMatrix[dPivotRow];
-					}
-				}
-			}
+	for(uint64_t i = 0; i < vColumns.size(); i++)
+		vForced[vColumns[i]] = true;
+	for(uint64_t i = 0; i < oMatrix.GetColumns(); i++)
+		if( !vForced[i] )
+			vKeep.push_back(i);
 
-		}
-		if(bPivotFound)
-			oTempMatrix.DeleteRow(dPivotRow);
-		
-	}
+	oElimination.GetRows(oTempMatrix, dRank, vKeep);
 	if( oTempMatrix.GetRows() == 0 ) {
 		std::cout << "Error: To much columns forced to zero. Resulting matrix is empty" << std::endl;
 	}
-	else {
-		for(unsigned int i = 0; i < vColumns.size(); i++)
-			oTempMatrix.DeleteColumn(vColumns[i]-i);
-	}
 
 	return oTempMatrix;
 }
@@ -513,49 +1059,147 @@ LowWeightSearch::CreateGaussMatrix(uint64_t dDim) {
 		oTemp.AddRow(oTempWord);
 	}
 
-	m_oGaussCombinations = oTemp;
+	m_oGaussCombinations = std::move(oTemp);
 
 }
 
 CodeMatrix &
 LowWeightSearch::GetGaussCombinations() {
+	if(m_bDeltaPending)
+		ApplyDeltaGauss();
 	return m_oGaussCombinations;
 }
 
+const SearchStatistics &
+LowWeightSearch::GetStatistics() const {
+	return m_oStatistics;
+}
+
+void
+LowWeightSearch::ApplyDeltaGauss() {
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dRows     = m_oDeltaZ.GetRows();
+	uint64_t dColumns  = m_oDeltaZ.GetColumns();
+	CodeMatrix oTemp;
+
+	// row i is the sum of the rows j before the search, for which the
+	// current row i has a one at the original position j, the ones of
+	// row i are at column i and at the ones of row i of Z
+	for(uint64_t i = 0; i < dRows && m_oGaussCombinations.GetRows() == dRows; i++) {
+		CodeWord oRow;
+		oRow.Resize(m_oGaussCombinations.GetColumns());
+		if(m_vDeltaPerm[i] < dRows)
+			oRow ^= m_oGaussCombinations[m_vDeltaPerm[i]];
+		for(uint64_t w = 0; w < m_oDeltaZ[i].GetLength64(); w++) {
+			// the last word is right aligned by At64
+			uint64_t dBits = std::min<uint64_t>(dWordSize, dColumns-w*dWordSize);
+			for(uint64_t dWord = m_oDeltaZ.At64(i, w); dWord != 0; dWord &= dWord-1) {
+				uint64_t j = m_vDeltaPerm[dRows + w*dWordSize + dBits-1 - __builtin_ctzll(dWord)];
+				if(j < dRows)
+					oRow ^= m_oGaussCombinations[j];
+			}
+		}
+		oTemp.AddRow(oRow);
+	}
+
+	m_oGaussCombinations = std::move(oTemp);
+	m_oDeltaZ            = CodeMatrix();
+	m_vDeltaPerm.clear();
+	m_bDeltaPending      = false;
+}
+
 CodeMatrix
 LowWeightSearch::CheckToGenerator(CodeMatrix & oCheckMatrix) {
 
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dLength   = oCheckMatrix.GetColumns();
 	CodeMatrix oGenerator;
+	CodeMatrix oZ;
+	CodeWord   oZero;
+	std::vector<uint64_t> vPerm;
 
-	for(uint64_t i = 0; i < oCheckMatrix.GetColumns()-oCheckMatrix.GetRows(); i++) {
-		CodeWord oTempWord;
-		for(uint64_t j = 0; j < oCheckMatrix.GetColumns(); j++)
-			oTempWord.PushBool(0);
-	}
-	for(uint64_t i = 0; i < oGenerator.GetRows(); i++)
-		oGenerator[i].SetBool(i, 1);
-		
-	for(uint64_t i = 0; i < oGenerator.GetRows(); i++) {
-		for(uint64_t j = oGenerator.GetRows(); j < oGenerator.GetColumns(); j++)
-			oGenerator[i].SetBool(j, oCheckMatrix[j-oGenerator.GetRows()].AtBool(i));
+	if( !CheckSystematicForm(oCheckMatrix, oZ, vPerm) )
+		return oGenerator;
+
+	for(uint64_t i = 0; i < dLength/dWordSize; i++)
+		oZero.Push64(0);
+	for(uint64_t i = dLength-dLength%dWordSize; i < dLength; i++)
+		oZero.PushBool(0);
+
+	// row i of the systematic generator matrix (I|Z), each column is
+	// moved back to its position in the check matrix
+	for(uint64_t i = 0; i < oZ.GetRows(); i++) {
+		CodeWord oRow = oZero;
+		oRow.SetBool(vPerm[i], 1);
+		for(uint64_t j = 0; j < oZ.GetColumns(); j++)
+			if(oZ.AtBool(i, j))
+				oRow.SetBool(vPerm[oZ.GetRows()+j], 1);
+		oGenerator.AddRow(oRow);
 	}
 
 	return oGenerator;
 }
 
-void
-LowWeightSearch::FreeHashTable(HashTableRecord** aHashTable,uint64_t dMaxTableSize) {
-	HashTableRecord * pTempRecord = NULL;
-	for(uint64_t i = 0; i < dMaxTableSize; i++) {
-		pTempRecord = aHashTable[i];
-		while(pTempRecord != NULL) {
-			aHashTable[i] = pTempRecord->pNextRecord;
-			delete pTempRecord;
-			pTempRecord = aHashTable[i];
-		}
-		delete aHashTable[i];
+bool
+LowWeightSearch::CheckSystematicForm(CodeMatrix & oCheckMatrix, CodeMatrix & oZ, std::vector<uint64_t> & vPerm) {
+
+	BlockElimination oElimination;
+	CodeMatrix oQ;
+	std::vector<uint64_t> vPivots, vColsQ;
+	uint64_t dRows    = oCheckMatrix.GetRows();
+	uint64_t dColumns = oCheckMatrix.GetColumns();
+
+	if( dRows == 0 || dRows >= dColumns ) {
+		std::cout << "Error: The check matrix needs fewer rows than columns." << std::endl;
+		return false;
 	}
-	memset(aHashTable, NULL, dMaxTableSize * sizeof(HashTableRecord*));
+
+	// the check matrix becomes (I|Q), row j is the pivot of column j
+	for(uint64_t j = 0; j < dRows; j++)
+		vPivots.push_back( j );
+	oElimination.Load(oCheckMatrix);
+	if( oElimination.Eliminate(vPivots, false, true) < dRows ) {
+		std::cout << "Error: Check matrix has not full rank." << std::endl;
+		return false;
+	}
+
+	for(uint64_t j = dRows; j < dColumns; j++)
+		vColsQ.push_back( j );
+	oElimination.GetRows(oQ, 0, vColsQ);
+	oZ = oQ.Transpose();
+
+	// the code words are (x|Qx) for all x, the information columns come first
+	const std::vector<uint64_t> & vColsPerm = oElimination.GetColumnPermutation();
+	vPerm.resize(dColumns);
+	for(uint64_t j = 0; j < dColumns-dRows; j++)
+		vPerm[j] = vColsPerm[dRows+j];
+	for(uint64_t j = 0; j < dRows; j++)
+		vPerm[dColumns-dRows+j] = vColsPerm[j];
+	return true;
+}
+
+void
+LowWeightSearch::ComputeSystematicForm(const CodeMatrix & oGenerator, SystematicForm & oForm) {
+	oForm.oGenerator = oGenerator;
+	oForm.vGaussPerm.clear();
+
+	m_oGaussCombinations = CodeMatrix();
+	m_bDeltaPending      = false;
+	if(m_bGaussTracking)
+		CreateGaussMatrix(oGenerator.GetRows());
+	if(!oForm.oGenerator.IsSystematic())
+		oForm.vGaussPerm = GaussMod2(oForm.oGenerator);
+	oForm.oGaussCombinations = m_oGaussCombinations;
+}
+
+void
+LowWeightSearch::SetSystematicForm(const SystematicForm * pForm) {
+	m_pSystematicForm = pForm;
+}
+
+void
+LowWeightSearch::SetBoard(SharedBoard * pBoard) {
+	m_pBoard = pBoard;
 }
 
 void
@@ -563,4 +1207,9 @@ LowWeightSearch::SetWeightVector(std::vector<uint64_t> & vWeights) {
 	m_vWeights = vWeights;
 }
 
+void
+LowWeightSearch::SetGaussTracking(bool bTrack) {
+	m_bGaussTracking = bTrack;
+}
+
 // EOF
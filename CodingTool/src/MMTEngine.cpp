@@ -0,0 +1,108 @@
+/*!
+  \file MMTEngine.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class MMTEngine.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "MMTEngine.h"
+
+MMTEngine::MMTEngine(void) {
+}
+
+MMTEngine::~MMTEngine(void) {
+}
+
+IsdEngine *
+MMTEngine::Clone() const {
+	return new MMTEngine(*this);
+}
+
+const char *
+MMTEngine::GetName() const {
+	return "mmt";
+}
+
+bool
+MMTEngine::SetParameters(Parameters & oParameters) {
+	if(!IsdEngine::SetParameters(oParameters))
+		return false;
+	if(m_dP < 2) {
+		std::cout << "Error: p has to be at least 2 for mmt." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void
+MMTEngine::Iterate(const CodeMatrix & oZ, RandomNumberGenerator & oRnGen, IsdCallback & oCallback) {
+	const CollisionIndex::Entry * pEntry = NULL;
+	uint64_t dHalf = oZ.GetRows()/2;
+	uint32_t dP1   = (m_dP+1)/2;
+	uint16_t aRows[MAXP];
+
+	Project(oZ, m_dSigma, oRnGen);
+
+	m_oList1.Clear();
+	m_oList2.Clear();
+	Enumerate(0, dHalf, 1, dP1, m_oList1);
+	Enumerate(dHalf, 2*dHalf, 1, dP1, m_oList2);
+
+	// l1 about log2 of the list size, at least one column is left for l2
+	uint64_t dL1 = 0;
+	while(dL1 < m_dSigma-1 && (static_cast<uint64_t>(1) << dL1) < m_oList1.Size())
+		dL1++;
+	if(dL1 < m_dSigma/2)
+		dL1 = m_dSigma/2;
+	if(dL1 > m_dSigma-1)
+		dL1 = m_dSigma-1;
+	uint64_t dMask   = (static_cast<uint64_t>(1) << dL1) - 1;
+	uint64_t dTarget = oRnGen.getRandomPosInteger(dMask+1);
+
+	// first level, sums with the target on the l1 columns
+	uint64_t dStart = SearchStatistics::Now();
+	m_oIndex.Clear();
+	m_oIndex.Reserve(m_oList2.Size());
+	for(uint64_t j = 0; j < m_oList2.Size(); j++)
+		m_oIndex.Insert(m_oList2.vKeys[j] & dMask, static_cast<uint32_t>(j), m_oList2.vCount[j]);
+
+	m_oMerged.Clear();
+	for(uint64_t i = 0; i < m_oList1.Size(); i++) {
+		uint64_t dKey = (m_oList1.vKeys[i] & dMask) ^ dTarget;
+		for(pEntry = m_oIndex.Find(dKey); pEntry != NULL; pEntry = m_oIndex.Next(pEntry)) {
+			uint32_t dRows1 = m_oList1.vCount[i];
+			uint32_t dRows2 = pEntry->dRows;
+			if(dRows1+dRows2 > m_dP)
+				continue;
+			// the halves are disjoint, no row cancels out
+			for(uint32_t r = 0; r < dRows1; r++)
+				aRows[r] = m_oList1.Rows(i)[r];
+			for(uint32_t r = 0; r < dRows2; r++)
+				aRows[dRows1+r] = m_oList2.Rows(pEntry->dCombination)[r];
+			m_oMerged.Add(aRows, dRows1+dRows2, (m_oList1.vKeys[i] ^ m_oList2.vKeys[pEntry->dCombination]) >> dL1);
+		}
+	}
+
+	UpdateIndexStatistics(dStart);
+
+	// second level, the target cancels out on the l1 columns
+	Collide(m_oMerged, oCallback);
+}
+
+//EOF
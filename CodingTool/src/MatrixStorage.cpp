@@ -0,0 +1,350 @@
+/*!
+  \file MatrixStorage.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class MatrixStorage.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+
+#include "MatrixStorage.h"
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MATRIXSTORAGE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MatrixStorage::MatrixStorage(void)
+  : m_pData(NULL), m_dRows(0), m_dCapacity(0), m_dWords(0), m_dStride(0), m_bView(false),
+    m_pMapping(NULL), m_dMappingSize(0) {
+}
+
+MatrixStorage::MatrixStorage(const MatrixStorage & oOther)
+  : m_pData(NULL), m_dRows(0), m_dCapacity(0), m_dWords(0), m_dStride(0), m_bView(false),
+    m_pMapping(NULL), m_dMappingSize(0) {
+	*this = oOther;
+}
+
+MatrixStorage::MatrixStorage(MatrixStorage && oOther) noexcept
+  : m_pData(NULL), m_dRows(0), m_dCapacity(0), m_dWords(0), m_dStride(0), m_bView(false),
+    m_pMapping(NULL), m_dMappingSize(0) {
+	Swap(oOther);
+}
+
+MatrixStorage::~MatrixStorage(void) {
+	Release();
+}
+
+void
+MatrixStorage::Reshape(uint64_t dRows, uint64_t dWords) {
+	uint64_t dStride = ComputeStride(dWords);
+
+	// reuse the memory if it is large enough
+	if(!m_bView && m_pMapping == NULL && m_pData != NULL && dStride > 0 && dRows*dStride <= m_dCapacity*m_dStride) {
+		memset(m_pData, 0, m_dCapacity*m_dStride*sizeof(uint64_t));
+		m_dCapacity = m_dCapacity*m_dStride/dStride;
+	}
+	else {
+		Release();
+		m_dCapacity = dRows;
+		m_pData     = Allocate(dRows*dStride);
+	}
+	m_dWords  = dWords;
+	m_dStride = dStride;
+	m_dRows   = dRows;
+}
+
+void
+MatrixStorage::Attach(uint64_t * pData, uint64_t dRows, uint64_t dWords, uint64_t dStride) {
+	Release();
+	m_pData     = pData;
+	m_dRows     = dRows;
+	m_dCapacity = dRows;
+	m_dWords    = dWords;
+	m_dStride   = dStride;
+	m_bView     = true;
+}
+
+const char *
+MatrixStorage::MapFile(const std::string & sFileName, uint64_t dOffset,
+                       uint64_t dRows, uint64_t dWords, uint64_t dStride) {
+#ifdef MATRIXSTORAGE_MMAP
+	int dFile = open(sFileName.c_str(), O_RDONLY);
+	if(dFile < 0)
+		return NULL;
+
+	struct stat oStat;
+	if(fstat(dFile, &oStat) != 0 || static_cast<uint64_t>(oStat.st_size) < dOffset+dRows*dStride*sizeof(uint64_t) ||
+	   oStat.st_size == 0) {
+		close(dFile);
+		return NULL;
+	}
+
+	// private mapping, changes of the matrix are not written to the file
+	void * pMapping = mmap(NULL, oStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, dFile, 0);
+	close(dFile);
+	if(pMapping == MAP_FAILED)
+		return NULL;
+
+	Release();
+	m_pMapping     = pMapping;
+	m_dMappingSize = oStat.st_size;
+	m_pData        = reinterpret_cast<uint64_t*>(static_cast<char*>(pMapping)+dOffset);
+	m_dRows        = dRows;
+	m_dCapacity    = dRows;
+	m_dWords       = dWords;
+	m_dStride      = dStride;
+	return static_cast<const char*>(pMapping);
+#else
+	return NULL;
+#endif
+}
+
+bool
+MatrixStorage::IsMapped() const {
+	return m_pMapping != NULL;
+}
+
+bool
+MatrixStorage::IsView() const {
+	return m_bView;
+}
+
+bool
+MatrixStorage::Reserve(uint64_t dRows) {
+	assert(!m_bView);
+	if(dRows <= m_dCapacity)
+		return false;
+
+	uint64_t * pData = Allocate(dRows*m_dStride);
+	if(m_dRows > 0)
+		memcpy(pData, m_pData, m_dRows*m_dStride*sizeof(uint64_t));
+	FreeData();
+	m_pData     = pData;
+	m_dCapacity = dRows;
+	return true;
+}
+
+bool
+MatrixStorage::AddRow() {
+	assert(!m_bView);
+	bool bMoved = false;
+	if(m_dRows == m_dCapacity)
+		bMoved = Reserve(m_dCapacity < 8 ? 8 : 2*m_dCapacity);
+	m_dRows++;
+	return bMoved;
+}
+
+bool
+MatrixStorage::Resize(uint64_t dRows) {
+	assert(!m_bView);
+	bool bMoved = false;
+	if(dRows > m_dCapacity)
+		bMoved = Reserve(dRows);
+	else if(dRows < m_dRows)
+		memset(Row(dRows), 0, (m_dRows-dRows)*m_dStride*sizeof(uint64_t));
+	m_dRows = dRows;
+	return bMoved;
+}
+
+void
+MatrixStorage::SwapRows(uint64_t dRow1, uint64_t dRow2) {
+	assert(dRow1 < m_dRows && dRow2 < m_dRows);
+	uint64_t * pRow1 = Row(dRow1);
+	uint64_t * pRow2 = Row(dRow2);
+	for(uint64_t i = 0; i < m_dWords; i++) {
+		uint64_t dTemp = pRow1[i];
+		pRow1[i] = pRow2[i];
+		pRow2[i] = dTemp;
+	}
+}
+
+void
+MatrixStorage::Swap(MatrixStorage & oOther) noexcept {
+	std::swap(m_pData, oOther.m_pData);
+	std::swap(m_dRows, oOther.m_dRows);
+	std::swap(m_dCapacity, oOther.m_dCapacity);
+	std::swap(m_dWords, oOther.m_dWords);
+	std::swap(m_dStride, oOther.m_dStride);
+	std::swap(m_bView, oOther.m_bView);
+	std::swap(m_pMapping, oOther.m_pMapping);
+	std::swap(m_dMappingSize, oOther.m_dMappingSize);
+}
+
+void
+MatrixStorage::DeleteRow(uint64_t dRow) {
+	assert(dRow < m_dRows && !m_bView);
+	memmove(Row(dRow), Row(dRow+1), (m_dRows-dRow-1)*m_dStride*sizeof(uint64_t));
+	m_dRows--;
+	// keep the unused rows zero
+	memset(Row(m_dRows), 0, m_dStride*sizeof(uint64_t));
+}
+
+void
+MatrixStorage::SetWords(uint64_t dWords) {
+	assert(dWords <= m_dStride && !m_bView);
+	// clear the words which are not used anymore
+	for(uint64_t i = 0; i < m_dRows; i++)
+		for(uint64_t j = dWords; j < m_dWords; j++)
+			Row(i)[j] = 0;
+	m_dWords = dWords;
+}
+
+void
+MatrixStorage::Clear() {
+	Release();
+}
+
+uint64_t *
+MatrixStorage::Row(uint64_t dRow) {
+	return m_pData + dRow*m_dStride;
+}
+
+const uint64_t *
+MatrixStorage::Row(uint64_t dRow) const {
+	return m_pData + dRow*m_dStride;
+}
+
+uint64_t
+MatrixStorage::GetRows() const {
+	return m_dRows;
+}
+
+uint64_t
+MatrixStorage::GetWords() const {
+	return m_dWords;
+}
+
+uint64_t
+MatrixStorage::GetStride() const {
+	return m_dStride;
+}
+
+uint64_t
+MatrixStorage::ComputeStride(uint64_t dWords) {
+	uint64_t dLine = CACHELINE/sizeof(uint64_t);
+
+	// long rows start at a cache line
+	if(2*dWords >= dLine)
+		return (dWords+dLine-1)/dLine*dLine;
+
+	// short rows never cross a cache line
+	uint64_t dStride = 1;
+	while(dStride < dWords)
+		dStride <<= 1;
+	return dStride;
+}
+
+MatrixStorage &
+MatrixStorage::operator=(const MatrixStorage & oOther) {
+	if(this == &oOther)
+		return *this;
+
+	// the memory is reused, e.g. if a chain saves its matrix for each checkpoint
+	uint64_t dSize = oOther.m_dRows*oOther.m_dStride;
+	if(!m_bView && m_pMapping == NULL && m_pData != NULL && dSize > 0 && dSize <= m_dCapacity*m_dStride) {
+		memcpy(m_pData, oOther.m_pData, dSize*sizeof(uint64_t));
+		memset(m_pData+dSize, 0, (m_dCapacity*m_dStride-dSize)*sizeof(uint64_t));
+		m_dCapacity = m_dCapacity*m_dStride/oOther.m_dStride;
+		m_dRows     = oOther.m_dRows;
+		m_dWords    = oOther.m_dWords;
+		m_dStride   = oOther.m_dStride;
+		return *this;
+	}
+
+	Release();
+	m_dRows     = oOther.m_dRows;
+	m_dCapacity = oOther.m_dRows;
+	m_dWords    = oOther.m_dWords;
+	m_dStride   = oOther.m_dStride;
+	if(m_dCapacity*m_dStride > 0) {
+		m_pData = Allocate(m_dCapacity*m_dStride);
+		memcpy(m_pData, oOther.m_pData, m_dRows*m_dStride*sizeof(uint64_t));
+	}
+	return *this;
+}
+
+MatrixStorage &
+MatrixStorage::operator=(MatrixStorage && oOther) noexcept {
+	if(this == &oOther)
+		return *this;
+
+	Release();
+	Swap(oOther);
+	return *this;
+}
+
+uint64_t *
+MatrixStorage::Allocate(uint64_t dWords) {
+	if(dWords == 0)
+		return NULL;
+
+	void * pData = NULL;
+#ifdef _MSC_VER
+	pData = _aligned_malloc(dWords*sizeof(uint64_t), CACHELINE);
+#else
+	if(posix_memalign(&pData, CACHELINE, dWords*sizeof(uint64_t)) != 0)
+		pData = NULL;
+#endif
+	assert(pData != NULL);
+	memset(pData, 0, dWords*sizeof(uint64_t));
+	return static_cast<uint64_t*>(pData);
+}
+
+void
+MatrixStorage::FreeData() {
+#ifdef MATRIXSTORAGE_MMAP
+	if(m_pMapping != NULL)
+		munmap(m_pMapping, m_dMappingSize);
+	else
+#endif
+	if(!m_bView)
+		Free(m_pData);
+	m_pData        = NULL;
+	m_pMapping     = NULL;
+	m_dMappingSize = 0;
+	m_bView        = false;
+}
+
+void
+MatrixStorage::Release() {
+	FreeData();
+	m_dRows     = 0;
+	m_dCapacity = 0;
+	m_dWords    = 0;
+	m_dStride   = 0;
+}
+
+void
+MatrixStorage::Free(uint64_t * pData) {
+#ifdef _MSC_VER
+	_aligned_free(pData);
+#else
+	free(pData);
+#endif
+}
+
+//EOF
@@ -31,6 +31,19 @@ const std::string Parameters::PERMUTE = "-pc";
 const std::string Parameters::CWFILE = "-cw";
 const std::string Parameters::CMFILE = "-cm";
 const std::string Parameters::DOUTPUT = "-d";
+const std::string Parameters::THREADS = "-t";
+const std::string Parameters::BINARYCW = "-ob";
+const std::string Parameters::ALGORITHM = "-a";
+const std::string Parameters::P = "-p";
+const std::string Parameters::CHECKPOINT = "-cp";
+const std::string Parameters::CHECKPOINTTIME = "-ct";
+const std::string Parameters::RESUME = "-r";
+const std::string Parameters::STATISTICS = "-sf";
+const std::string Parameters::STATISTICSTIME = "-st";
+const std::string Parameters::SEED = "-sd";
+const std::string Parameters::CHECKMATRIX = "-hm";
+const std::string Parameters::BOARD = "-bd";
+const std::string Parameters::PIN = "-pn";
 
 Parameters::Parameters(void) {
 
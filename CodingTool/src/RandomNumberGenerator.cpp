@@ -24,16 +24,39 @@
 #include "RandomNumberGenerator.h"
 
 
+#include <algorithm>
+#include <unordered_set>
+
+//! Rotates a 64-bit word to the left.
+static inline uint64_t
+Rotl(uint64_t dWord, uint32_t dShift) {
+	return (dWord << dShift) | (dWord >> (64-dShift));
+}
+
+//! The next output of SplitMix64, which expands a seed into a state.
+static uint64_t
+SplitMix64(uint64_t & dState) {
+	uint64_t z = (dState += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
 RandomNumberGenerator::RandomNumberGenerator()
 {
-	m_dSeed = static_cast<uint32_t>(time(NULL));
+	uint64_t dSeed = static_cast<uint64_t>(time(NULL));
 #ifdef __unix__
 	std::fstream oRandFile;
     oRandFile.open("/dev/urandom");
-    oRandFile.read(reinterpret_cast<char *>(&m_dSeed), sizeof(m_dSeed));
+    oRandFile.read(reinterpret_cast<char *>(&dSeed), sizeof(dSeed));
     oRandFile.close();
 #endif
-	m_oGenerator.seed(m_dSeed);
+	setSeed(dSeed);
+}
+
+RandomNumberGenerator::RandomNumberGenerator(uint64_t dSeed)
+{
+	setSeed(dSeed);
 }
 
 RandomNumberGenerator::~RandomNumberGenerator()
@@ -41,42 +64,127 @@ RandomNumberGenerator::~RandomNumberGenerator()
 	
 }
 
+uint64_t
+RandomNumberGenerator::getRandom64()
+{
+	uint64_t dResult = Rotl(m_aState[1]*5, 7)*9;
+	uint64_t dTemp   = m_aState[1] << 17;
+
+	m_aState[2] ^= m_aState[0];
+	m_aState[3] ^= m_aState[1];
+	m_aState[1] ^= m_aState[2];
+	m_aState[0] ^= m_aState[3];
+	m_aState[2] ^= dTemp;
+	m_aState[3]  = Rotl(m_aState[3], 45);
+	return dResult;
+}
+
 uint64_t 
 RandomNumberGenerator::getRandomPosInteger(uint64_t n)
 {
-	uint64_t dTemp = m_oGenerator();
-	dTemp = (dTemp << 32) | m_oGenerator();
-	uint64_t random = dTemp % n;
-	return random;
+	// words below the threshold are rejected, the rest is uniform modulo n
+	uint64_t dThreshold = (0-n) % n;
+	uint64_t dRandom    = getRandom64();
+	while(dRandom < dThreshold)
+		dRandom = getRandom64();
+	return dRandom % n;
 }
 
 std::vector<uint64_t>
 RandomNumberGenerator::getRandomPosVector(uint64_t lb,
 		uint64_t ub, uint64_t ln)
 {
-	uint64_t rn = 0;
-	
-	std::vector<uint64_t> vI, vReturn;
-	
-	for(uint64_t i = lb; i <= ub; i++)
-		vI.push_back(i);
-	
-	for(uint32_t i = 0; i < ln; i++)
-	{
-		if( ub-lb-i <=0 ) {
-			vReturn.push_back(vI.at(0));
-			break;
+	std::vector<uint64_t> vReturn;
+	getRandomPosVector(lb, ub, ln, vReturn);
+	return vReturn;
+}
+
+void
+RandomNumberGenerator::getRandomPosVector(uint64_t lb, uint64_t ub, uint64_t ln,
+                                          std::vector<uint64_t> & vReturn)
+{
+	uint64_t n = ub-lb+1;
+
+	vReturn.clear();
+
+	if(ln > n)
+		ln = n;
+	vReturn.reserve(4*ln >= n ? n : ln);
+
+	if(4*ln >= n) {
+		// partial Fisher-Yates shuffle of the whole interval
+		for(uint64_t i = 0; i < n; i++)
+			vReturn.push_back(lb+i);
+		for(uint64_t i = 0; i < ln; i++)
+			std::swap(vReturn[i], vReturn[i+getRandomPosInteger(n-i)]);
+		vReturn.resize(ln);
+	}
+	else if(ln <= 64) {
+		// Floyd's algorithm, a linear search is faster than a set for few values
+		for(uint64_t j = n-ln; j < n; j++) {
+			uint64_t t = lb+getRandomPosInteger(j+1);
+			if(std::find(vReturn.begin(), vReturn.end(), t) != vReturn.end())
+				t = lb+j;
+			vReturn.push_back(t);
+		}
+	}
+	else {
+		std::unordered_set<uint64_t> oSelected(2*ln);
+		for(uint64_t j = n-ln; j < n; j++) {
+			uint64_t t = lb+getRandomPosInteger(j+1);
+			if(!oSelected.insert(t).second) {
+				t = lb+j;
+				oSelected.insert(t);
+			}
+			vReturn.push_back(t);
 		}
-		rn = getRandomPosInteger((ub-lb)-i);
-		vReturn.push_back(vI.at(rn));
-		vI.erase(vI.begin()+rn);
 	}
-	
-	return vReturn;
 }
 
-uint32_t 
+uint64_t 
 RandomNumberGenerator::getSeed()
 {
 	return m_dSeed;
 }
+
+void
+RandomNumberGenerator::setSeed(uint64_t dSeed)
+{
+	uint64_t dState = dSeed;
+
+	m_dSeed = dSeed;
+	for(uint32_t i = 0; i < STATEWORDS; i++)
+		m_aState[i] = SplitMix64(dState);
+}
+
+void
+RandomNumberGenerator::jump()
+{
+	static const uint64_t aJump[STATEWORDS] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+	                                            0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+	uint64_t aState[STATEWORDS] = { 0, 0, 0, 0 };
+
+	for(uint32_t i = 0; i < STATEWORDS; i++)
+		for(uint32_t b = 0; b < 64; b++) {
+			if(aJump[i] & (static_cast<uint64_t>(1) << b))
+				for(uint32_t j = 0; j < STATEWORDS; j++)
+					aState[j] ^= m_aState[j];
+			getRandom64();
+		}
+	for(uint32_t j = 0; j < STATEWORDS; j++)
+		m_aState[j] = aState[j];
+}
+
+void
+RandomNumberGenerator::getState(uint64_t * pState)
+{
+	for(uint32_t i = 0; i < STATEWORDS; i++)
+		pState[i] = m_aState[i];
+}
+
+void
+RandomNumberGenerator::setState(const uint64_t * pState)
+{
+	for(uint32_t i = 0; i < STATEWORDS; i++)
+		m_aState[i] = pState[i];
+}
@@ -0,0 +1,404 @@
+/*!
+  \file RowKernels.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file implements the row kernels and the CPU dispatch.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <atomic>
+#include <cassert>
+
+#include "RowKernels.h"
+#include "HammingWeight.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROWKERNELS_X86
+#include <immintrin.h>
+#endif
+
+typedef uint64_t (*RowWeightFunction)(const uint64_t *, uint64_t);
+typedef uint64_t (*RowXorWeightFunction)(uint64_t *, const uint64_t *, uint64_t);
+typedef uint64_t (*RowsXorWeightFunction)(const uint64_t * const *, uint32_t, uint64_t, uint64_t);
+
+static uint64_t ResolveRowWeight(const uint64_t * pData, uint64_t dWords);
+static uint64_t ResolveRowXorWeight(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords);
+static uint64_t ResolveRowsXorWeight(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound);
+
+// the first call of a kernel selects the implementation, the pointers
+// are atomic since several search chains may trigger the selection
+static std::atomic<RowWeightFunction>     g_pRowWeight(&ResolveRowWeight);
+static std::atomic<RowXorWeightFunction>  g_pRowXorWeight(&ResolveRowXorWeight);
+static std::atomic<RowsXorWeightFunction> g_pRowsXorWeight(&ResolveRowsXorWeight);
+static std::atomic<KernelType>            g_eKernel(KERNEL_AUTO);
+
+//////////////////////////////////////////////////////////////////////
+// scalar
+
+static uint64_t
+RowWeightScalar(const uint64_t * pData, uint64_t dWords) {
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < dWords; i++)
+		dWeight += HammingWeight(pData[i]);
+	return dWeight;
+}
+
+static uint64_t
+RowXorWeightScalar(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords) {
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < dWords; i++) {
+		pDst[i] ^= pSrc[i];
+		dWeight += HammingWeight(pDst[i]);
+	}
+	return dWeight;
+}
+
+static uint64_t
+RowsXorWeightScalar(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound) {
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < dWords; i += ROWCHUNK) {
+		uint64_t dEnd = i+ROWCHUNK < dWords ? i+ROWCHUNK : dWords;
+		for(uint64_t j = i; j < dEnd; j++) {
+			uint64_t dData = ppRows[0][j];
+			for(uint32_t k = 1; k < dRows; k++)
+				dData ^= ppRows[k][j];
+			dWeight += HammingWeight(dData);
+		}
+		if(dWeight >= dBound)
+			break;
+	}
+	return dWeight;
+}
+
+#ifdef ROWKERNELS_X86
+
+//////////////////////////////////////////////////////////////////////
+// SSE4.2 POPCNT
+
+__attribute__((target("popcnt")))
+static uint64_t
+RowWeightPopcnt(const uint64_t * pData, uint64_t dWords) {
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < dWords; i++)
+		dWeight += __builtin_popcountll(pData[i]);
+	return dWeight;
+}
+
+__attribute__((target("popcnt")))
+static uint64_t
+RowXorWeightPopcnt(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords) {
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < dWords; i++) {
+		pDst[i] ^= pSrc[i];
+		dWeight += __builtin_popcountll(pDst[i]);
+	}
+	return dWeight;
+}
+
+__attribute__((target("popcnt")))
+static uint64_t
+RowsXorWeightPopcnt(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound) {
+	uint64_t dWeight = 0;
+	for(uint64_t i = 0; i < dWords; i += ROWCHUNK) {
+		uint64_t dEnd = i+ROWCHUNK < dWords ? i+ROWCHUNK : dWords;
+		for(uint64_t j = i; j < dEnd; j++) {
+			uint64_t dData = ppRows[0][j];
+			for(uint32_t k = 1; k < dRows; k++)
+				dData ^= ppRows[k][j];
+			dWeight += __builtin_popcountll(dData);
+		}
+		if(dWeight >= dBound)
+			break;
+	}
+	return dWeight;
+}
+
+//////////////////////////////////////////////////////////////////////
+// AVX2, nibble lookup with vpshufb (Mula, Kurz, Lemire)
+
+__attribute__((target("avx2")))
+static inline __m256i
+PopCount256(__m256i oData) {
+	const __m256i oTable = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+	                                        0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+	const __m256i oLow   = _mm256_set1_epi8(0x0F);
+	__m256i oLo = _mm256_and_si256(oData, oLow);
+	__m256i oHi = _mm256_and_si256(_mm256_srli_epi16(oData, 4), oLow);
+	__m256i oCnt = _mm256_add_epi8(_mm256_shuffle_epi8(oTable, oLo),
+	                               _mm256_shuffle_epi8(oTable, oHi));
+	return _mm256_sad_epu8(oCnt, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2")))
+static inline uint64_t
+Sum256(__m256i oSum) {
+	return static_cast<uint64_t>(_mm256_extract_epi64(oSum, 0)) +
+	       static_cast<uint64_t>(_mm256_extract_epi64(oSum, 1)) +
+	       static_cast<uint64_t>(_mm256_extract_epi64(oSum, 2)) +
+	       static_cast<uint64_t>(_mm256_extract_epi64(oSum, 3));
+}
+
+__attribute__((target("avx2,popcnt")))
+static uint64_t
+RowWeightAVX2(const uint64_t * pData, uint64_t dWords) {
+	__m256i oSum = _mm256_setzero_si256();
+	uint64_t i = 0;
+	for(; i+4 <= dWords; i += 4) {
+		__m256i oData = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData+i));
+		oSum = _mm256_add_epi64(oSum, PopCount256(oData));
+	}
+	uint64_t dWeight = Sum256(oSum);
+	for(; i < dWords; i++)
+		dWeight += __builtin_popcountll(pData[i]);
+	return dWeight;
+}
+
+__attribute__((target("avx2,popcnt")))
+static uint64_t
+RowXorWeightAVX2(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords) {
+	__m256i oSum = _mm256_setzero_si256();
+	uint64_t i = 0;
+	for(; i+4 <= dWords; i += 4) {
+		__m256i oData = _mm256_xor_si256(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDst+i)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc+i)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst+i), oData);
+		oSum = _mm256_add_epi64(oSum, PopCount256(oData));
+	}
+	uint64_t dWeight = Sum256(oSum);
+	for(; i < dWords; i++) {
+		pDst[i] ^= pSrc[i];
+		dWeight += __builtin_popcountll(pDst[i]);
+	}
+	return dWeight;
+}
+
+__attribute__((target("avx2,popcnt")))
+static uint64_t
+RowsXorWeightAVX2(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound) {
+	uint64_t dWeight = 0;
+	uint64_t i = 0;
+	// ROWCHUNK words are two 256-bit registers
+	for(; i+ROWCHUNK <= dWords; i += ROWCHUNK) {
+		__m256i oData0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ppRows[0]+i));
+		__m256i oData1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ppRows[0]+i+4));
+		for(uint32_t k = 1; k < dRows; k++) {
+			oData0 = _mm256_xor_si256(oData0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ppRows[k]+i)));
+			oData1 = _mm256_xor_si256(oData1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ppRows[k]+i+4)));
+		}
+		dWeight += Sum256(_mm256_add_epi64(PopCount256(oData0), PopCount256(oData1)));
+		if(dWeight >= dBound)
+			return dWeight;
+	}
+	for(; i < dWords; i++) {
+		uint64_t dData = ppRows[0][i];
+		for(uint32_t k = 1; k < dRows; k++)
+			dData ^= ppRows[k][i];
+		dWeight += __builtin_popcountll(dData);
+	}
+	return dWeight;
+}
+
+//////////////////////////////////////////////////////////////////////
+// AVX-512 with VPOPCNTQ, the tail is handled by masked loads
+
+__attribute__((target("avx512f")))
+static inline uint64_t
+Sum512(__m512i oSum) {
+	uint64_t aSum[8];
+	_mm512_storeu_si512(aSum, oSum);
+	return aSum[0]+aSum[1]+aSum[2]+aSum[3]+aSum[4]+aSum[5]+aSum[6]+aSum[7];
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint64_t
+RowWeightAVX512(const uint64_t * pData, uint64_t dWords) {
+	__m512i oSum = _mm512_setzero_si512();
+	uint64_t i = 0;
+	for(; i+8 <= dWords; i += 8)
+		oSum = _mm512_add_epi64(oSum, _mm512_popcnt_epi64(_mm512_loadu_si512(pData+i)));
+	if(i < dWords) {
+		__mmask8 dMask = static_cast<__mmask8>((1u << (dWords-i)) - 1);
+		oSum = _mm512_add_epi64(oSum, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(dMask, pData+i)));
+	}
+	return Sum512(oSum);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint64_t
+RowXorWeightAVX512(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords) {
+	__m512i oSum = _mm512_setzero_si512();
+	uint64_t i = 0;
+	for(; i+8 <= dWords; i += 8) {
+		__m512i oData = _mm512_xor_si512(_mm512_loadu_si512(pDst+i), _mm512_loadu_si512(pSrc+i));
+		_mm512_storeu_si512(pDst+i, oData);
+		oSum = _mm512_add_epi64(oSum, _mm512_popcnt_epi64(oData));
+	}
+	if(i < dWords) {
+		__mmask8 dMask = static_cast<__mmask8>((1u << (dWords-i)) - 1);
+		__m512i oData = _mm512_xor_si512(_mm512_maskz_loadu_epi64(dMask, pDst+i),
+		                                 _mm512_maskz_loadu_epi64(dMask, pSrc+i));
+		_mm512_mask_storeu_epi64(pDst+i, dMask, oData);
+		oSum = _mm512_add_epi64(oSum, _mm512_popcnt_epi64(oData));
+	}
+	return Sum512(oSum);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint64_t
+RowsXorWeightAVX512(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound) {
+	uint64_t dWeight = 0;
+	// ROWCHUNK words are one 512-bit register
+	for(uint64_t i = 0; i < dWords; i += ROWCHUNK) {
+		__mmask8 dMask = 0xFF;
+		if(i+ROWCHUNK > dWords)
+			dMask = static_cast<__mmask8>((1u << (dWords-i)) - 1);
+		__m512i oData = _mm512_maskz_loadu_epi64(dMask, ppRows[0]+i);
+		for(uint32_t k = 1; k < dRows; k++)
+			oData = _mm512_xor_si512(oData, _mm512_maskz_loadu_epi64(dMask, ppRows[k]+i));
+		dWeight += Sum512(_mm512_popcnt_epi64(oData));
+		if(dWeight >= dBound)
+			break;
+	}
+	return dWeight;
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// dispatch
+
+//! Returns true if the CPU supports the given kernel.
+static bool
+IsSupported(KernelType eType) {
+	switch(eType) {
+	case KERNEL_AUTO:
+	case KERNEL_SCALAR:
+		return true;
+#ifdef ROWKERNELS_X86
+	case KERNEL_POPCNT:
+		return __builtin_cpu_supports("popcnt");
+	case KERNEL_AVX2:
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+	case KERNEL_AVX512:
+		return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+	default:
+		return false;
+	}
+}
+
+bool
+SetRowKernel(KernelType eType) {
+	if(!IsSupported(eType))
+		return false;
+
+	if(eType == KERNEL_AUTO) {
+		eType = KERNEL_SCALAR;
+		if(IsSupported(KERNEL_AVX512))
+			eType = KERNEL_AVX512;
+		else if(IsSupported(KERNEL_AVX2))
+			eType = KERNEL_AVX2;
+		else if(IsSupported(KERNEL_POPCNT))
+			eType = KERNEL_POPCNT;
+	}
+
+	switch(eType) {
+#ifdef ROWKERNELS_X86
+	case KERNEL_POPCNT:
+		g_pRowWeight     = &RowWeightPopcnt;
+		g_pRowXorWeight  = &RowXorWeightPopcnt;
+		g_pRowsXorWeight = &RowsXorWeightPopcnt;
+		break;
+	case KERNEL_AVX2:
+		g_pRowWeight     = &RowWeightAVX2;
+		g_pRowXorWeight  = &RowXorWeightAVX2;
+		g_pRowsXorWeight = &RowsXorWeightAVX2;
+		break;
+	case KERNEL_AVX512:
+		g_pRowWeight     = &RowWeightAVX512;
+		g_pRowXorWeight  = &RowXorWeightAVX512;
+		g_pRowsXorWeight = &RowsXorWeightAVX512;
+		break;
+#endif
+	default:
+		g_pRowWeight     = &RowWeightScalar;
+		g_pRowXorWeight  = &RowXorWeightScalar;
+		g_pRowsXorWeight = &RowsXorWeightScalar;
+		break;
+	}
+	g_eKernel = eType;
+	return true;
+}
+
+KernelType
+GetRowKernel() {
+	if(g_eKernel == KERNEL_AUTO)
+		SetRowKernel(KERNEL_AUTO);
+	return g_eKernel;
+}
+
+const char *
+GetRowKernelName() {
+	switch(GetRowKernel()) {
+	case KERNEL_POPCNT:
+		return "popcnt";
+	case KERNEL_AVX2:
+		return "avx2";
+	case KERNEL_AVX512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
+}
+
+static uint64_t
+ResolveRowWeight(const uint64_t * pData, uint64_t dWords) {
+	SetRowKernel(KERNEL_AUTO);
+	return g_pRowWeight.load(std::memory_order_relaxed)(pData, dWords);
+}
+
+static uint64_t
+ResolveRowXorWeight(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords) {
+	SetRowKernel(KERNEL_AUTO);
+	return g_pRowXorWeight.load(std::memory_order_relaxed)(pDst, pSrc, dWords);
+}
+
+static uint64_t
+ResolveRowsXorWeight(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound) {
+	SetRowKernel(KERNEL_AUTO);
+	return g_pRowsXorWeight.load(std::memory_order_relaxed)(ppRows, dRows, dWords, dBound);
+}
+
+uint64_t
+RowWeight(const uint64_t * pData, uint64_t dWords) {
+	return g_pRowWeight.load(std::memory_order_relaxed)(pData, dWords);
+}
+
+uint64_t
+RowXorWeight(uint64_t * pDst, const uint64_t * pSrc, uint64_t dWords) {
+	return g_pRowXorWeight.load(std::memory_order_relaxed)(pDst, pSrc, dWords);
+}
+
+uint64_t
+RowsXorWeight(const uint64_t * const * ppRows, uint32_t dRows, uint64_t dWords, uint64_t dBound) {
+	assert(dRows > 0 && dRows <= MAXXORROWS);
+	return g_pRowsXorWeight.load(std::memory_order_relaxed)(ppRows, dRows, dWords, dBound);
+}
+
+//EOF
@@ -0,0 +1,131 @@
+/*!
+  \file SearchStatistics.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class SearchStatistics.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#include <chrono>
+#include <iostream>
+
+#include "SearchStatistics.h"
+
+//! Converts nanoseconds to seconds.
+static double
+Seconds(uint64_t dNanoseconds) {
+	return static_cast<double>(dNanoseconds)*1e-9;
+}
+
+SearchStatistics::SearchStatistics(void) {
+	Clear();
+}
+
+void
+SearchStatistics::Clear() {
+	dIterations     = 0;
+	dCombinations   = 0;
+	dCollisions     = 0;
+	dCandidates     = 0;
+	dEarlyAborts    = 0;
+	dImprovements   = 0;
+	dIndexMemory    = 0;
+	dProjectTime    = 0;
+	dEnumerateTime  = 0;
+	dCollideTime    = 0;
+	dCandidateTime  = 0;
+	dBuildTime      = 0;
+	dDeltaGaussTime = 0;
+}
+
+void
+SearchStatistics::Add(const SearchStatistics & oOther) {
+	dIterations     += oOther.dIterations;
+	dCombinations   += oOther.dCombinations;
+	dCollisions     += oOther.dCollisions;
+	dCandidates     += oOther.dCandidates;
+	dEarlyAborts    += oOther.dEarlyAborts;
+	dImprovements   += oOther.dImprovements;
+	dProjectTime    += oOther.dProjectTime;
+	dEnumerateTime  += oOther.dEnumerateTime;
+	dCollideTime    += oOther.dCollideTime;
+	dCandidateTime  += oOther.dCandidateTime;
+	dBuildTime      += oOther.dBuildTime;
+	dDeltaGaussTime += oOther.dDeltaGaussTime;
+	if(oOther.dIndexMemory > dIndexMemory)
+		dIndexMemory = oOther.dIndexMemory;
+}
+
+uint64_t
+SearchStatistics::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void
+SearchStatistics::WriteJson(std::ostream & oStream, double dSeconds, uint64_t dMinWeight) const {
+	oStream << "{\"seconds\":" << dSeconds
+	        << ",\"iterations\":" << dIterations
+	        << ",\"iterations_per_second\":" << (dSeconds > 0 ? dIterations/dSeconds : 0)
+	        << ",\"min_weight\":" << dMinWeight
+	        << ",\"combinations\":" << dCombinations
+	        << ",\"collisions\":" << dCollisions
+	        << ",\"candidates\":" << dCandidates
+	        << ",\"early_aborts\":" << dEarlyAborts
+	        << ",\"improvements\":" << dImprovements
+	        << ",\"index_memory\":" << dIndexMemory
+	        << ",\"project_seconds\":" << Seconds(dProjectTime)
+	        << ",\"enumerate_seconds\":" << Seconds(dEnumerateTime)
+	        << ",\"collide_seconds\":" << Seconds(dCollideTime)
+	        << ",\"candidate_seconds\":" << Seconds(dCandidateTime)
+	        << ",\"build_seconds\":" << Seconds(dBuildTime)
+	        << ",\"delta_gauss_seconds\":" << Seconds(dDeltaGaussTime)
+	        << "}" << std::endl;
+}
+
+void
+SearchStatistics::WriteCsvHeader(std::ostream & oStream) {
+	oStream << "seconds,iterations,iterations_per_second,min_weight,combinations,collisions,"
+	        << "candidates,early_aborts,improvements,index_memory,project_seconds,enumerate_seconds,"
+	        << "collide_seconds,candidate_seconds,build_seconds,delta_gauss_seconds" << std::endl;
+}
+
+void
+SearchStatistics::WriteCsv(std::ostream & oStream, double dSeconds, uint64_t dMinWeight) const {
+	oStream << dSeconds << "," << dIterations << "," << (dSeconds > 0 ? dIterations/dSeconds : 0)
+	        << "," << dMinWeight << "," << dCombinations << "," << dCollisions
+	        << "," << dCandidates << "," << dEarlyAborts << "," << dImprovements
+	        << "," << dIndexMemory << "," << Seconds(dProjectTime) << "," << Seconds(dEnumerateTime)
+	        << "," << Seconds(dCollideTime) << "," << Seconds(dCandidateTime)
+	        << "," << Seconds(dBuildTime) << "," << Seconds(dDeltaGaussTime) << std::endl;
+}
+
+void
+SearchStatistics::Print(double dSeconds) const {
+	std::cout << "Info: " << dIterations << " iterations in " << dSeconds << " s ("
+	          << (dSeconds > 0 ? dIterations/dSeconds : 0) << " per second)" << std::endl;
+	std::cout << "Info: " << dCombinations << " combinations, " << dCollisions << " collisions, "
+	          << dCandidates << " candidates, " << dEarlyAborts << " early aborts, "
+	          << dImprovements << " improvements" << std::endl;
+	std::cout << "Info: Hash table " << dIndexMemory << " bytes per chain" << std::endl;
+	std::cout << "Info: Time project " << Seconds(dProjectTime) << " s, enumerate " << Seconds(dEnumerateTime)
+	          << " s, collide " << Seconds(dCollideTime) << " s (candidates " << Seconds(dCandidateTime)
+	          << " s), build " << Seconds(dBuildTime) << " s, delta gauss " << Seconds(dDeltaGaussTime)
+	          << " s" << std::endl;
+}
+
+//EOF
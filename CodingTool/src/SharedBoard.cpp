@@ -0,0 +1,398 @@
+/*!
+  \file SharedBoard.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class SharedBoard.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <new>
+#include <cerrno>
+#include <cstring>
+#include <cassert>
+#include <iomanip>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "SharedBoard.h"
+#include "SearchStatistics.h"
+
+// the atomics are shared between processes, they must not use a lock
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64-bit atomics have to be lock-free");
+
+static const uint64_t BOARDMAGIC   = 0x445241424354ULL; //!< Marks an initialized board ("CTBARD").
+static const uint64_t BOARDVERSION = 1;                 //!< Version of the layout of the segment.
+
+//! The header of the segment, followed by the worker slots and the code word.
+struct SharedBoard::Header {
+	std::atomic<uint64_t> dMagic;       //!< BOARDMAGIC after the creator initialized the segment.
+	uint64_t              dVersion;     //!< BOARDVERSION.
+	uint64_t              dLength;      //!< The length of the code.
+	uint64_t              dMaxWorkers;  //!< Number of worker slots.
+	std::atomic<uint64_t> dWorkers;     //!< Number of workers which joined.
+	std::atomic<uint64_t> dBestWeight;  //!< The global minimum weight.
+	std::atomic<uint64_t> dGeneration;  //!< Number of improvements of the global minimum.
+	std::atomic<uint64_t> dLock;        //!< Spin lock of the code word.
+	std::atomic<uint64_t> dStop;        //!< Nonzero if the workers should stop.
+};
+
+//! The slot of one worker.
+struct SharedBoard::Worker {
+	std::atomic<uint64_t> dPid;         //!< The process id.
+	std::atomic<uint64_t> dState;       //!< FREE, RUNNING or FINISHED.
+	std::atomic<uint64_t> dIterations;  //!< Number of finished iterations.
+	std::atomic<uint64_t> dMinWeight;   //!< The minimum weight found by the worker.
+	std::atomic<uint64_t> dUpdated;     //!< Time of the last update.
+};
+
+SharedBoard::SharedBoard(void)
+  : m_pSegment(NULL), m_dSize(0), m_pHeader(NULL), m_pWorkers(NULL),
+    m_bCreator(false), m_dLastIterations(0), m_dLastTime(0) {
+}
+
+SharedBoard::~SharedBoard(void) {
+	Detach();
+}
+
+bool
+SharedBoard::Create(const std::string & sName, uint64_t dLength, uint32_t dMaxWorkers) {
+	Detach();
+	if(dLength == 0 || dMaxWorkers == 0) {
+		std::cout << "Error: The board needs a code length and at least one worker." << std::endl;
+		return false;
+	}
+
+	m_sName = "/" + sName;
+	int iFile = shm_open(m_sName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	if(iFile < 0) {
+		std::cout << "Error: Can not create the board " << sName << " (" << strerror(errno) << ")." << std::endl;
+		return false;
+	}
+
+	uint64_t dSize = SegmentSize(dLength, dMaxWorkers);
+	if(ftruncate(iFile, dSize) != 0 || !Map(iFile, dSize)) {
+		std::cout << "Error: Can not create the board " << sName << "." << std::endl;
+		close(iFile);
+		shm_unlink(m_sName.c_str());
+		return false;
+	}
+	close(iFile);
+	m_bCreator = true;
+
+	// the segment is zero, the other processes wait for the magic number
+	new (m_pHeader) Header;
+	for(uint32_t i = 0; i < dMaxWorkers; i++)
+		new (&m_pWorkers[i]) Worker;
+	m_pHeader->dVersion    = BOARDVERSION;
+	m_pHeader->dLength     = dLength;
+	m_pHeader->dMaxWorkers = dMaxWorkers;
+	m_pHeader->dWorkers    = 0;
+	m_pHeader->dBestWeight = UINT64_MAX;
+	m_pHeader->dGeneration = 0;
+	m_pHeader->dLock       = 0;
+	m_pHeader->dStop       = 0;
+	m_pHeader->dMagic.store(BOARDMAGIC, std::memory_order_release);
+
+	m_dLastTime = SearchStatistics::Now();
+	return true;
+}
+
+bool
+SharedBoard::Attach(const std::string & sName, uint64_t dLength) {
+	struct stat oStat;
+
+	Detach();
+	m_sName = "/" + sName;
+	int iFile = shm_open(m_sName.c_str(), O_RDWR, 0600);
+	if(iFile < 0) {
+		std::cout << "Error: Can not open the board " << sName << " (" << strerror(errno) << ")." << std::endl;
+		return false;
+	}
+
+	// the creator may still be setting the size
+	for(uint32_t i = 0; i < 1000; i++) {
+		if(fstat(iFile, &oStat) == 0 && static_cast<uint64_t>(oStat.st_size) >= sizeof(Header))
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if(static_cast<uint64_t>(oStat.st_size) < sizeof(Header) || !Map(iFile, oStat.st_size)) {
+		std::cout << "Error: The board " << sName << " is not initialized." << std::endl;
+		close(iFile);
+		Detach();
+		return false;
+	}
+	close(iFile);
+
+	for(uint32_t i = 0; i < 1000 && m_pHeader->dMagic.load(std::memory_order_acquire) != BOARDMAGIC; i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	if(m_pHeader->dMagic.load(std::memory_order_acquire) != BOARDMAGIC || m_pHeader->dVersion != BOARDVERSION ||
+	   m_dSize < SegmentSize(m_pHeader->dLength, m_pHeader->dMaxWorkers)) {
+		std::cout << "Error: The board " << sName << " is not initialized." << std::endl;
+		Detach();
+		return false;
+	}
+	if(m_pHeader->dLength != dLength) {
+		std::cout << "Error: The board " << sName << " has code length " << m_pHeader->dLength
+		          << ", not " << dLength << "." << std::endl;
+		Detach();
+		return false;
+	}
+
+	m_dLastTime = SearchStatistics::Now();
+	return true;
+}
+
+bool
+SharedBoard::Map(int iFile, uint64_t dSize) {
+	void * pSegment = mmap(NULL, dSize, PROT_READ | PROT_WRITE, MAP_SHARED, iFile, 0);
+	if(pSegment == MAP_FAILED)
+		return false;
+
+	m_pSegment = pSegment;
+	m_dSize    = dSize;
+	m_pHeader  = static_cast<Header*>(pSegment);
+	m_pWorkers = reinterpret_cast<Worker*>(m_pHeader+1);
+	return true;
+}
+
+void
+SharedBoard::Detach() {
+	if(m_pSegment != NULL)
+		munmap(m_pSegment, m_dSize);
+	if(m_bCreator)
+		shm_unlink(m_sName.c_str());
+	m_pSegment = NULL;
+	m_dSize    = 0;
+	m_pHeader  = NULL;
+	m_pWorkers = NULL;
+	m_bCreator = false;
+}
+
+bool
+SharedBoard::IsAttached() const {
+	return m_pHeader != NULL;
+}
+
+uint64_t
+SharedBoard::SegmentSize(uint64_t dLength, uint32_t dMaxWorkers) {
+	return sizeof(Header) + dMaxWorkers*sizeof(Worker) + (dLength+63)/64*sizeof(uint64_t);
+}
+
+uint32_t
+SharedBoard::Join() {
+	assert(IsAttached());
+
+	uint64_t dWorker = m_pHeader->dWorkers++;
+	if(dWorker >= m_pHeader->dMaxWorkers) {
+		m_pHeader->dWorkers--;
+		std::cout << "Error: The board is full, at most " << m_pHeader->dMaxWorkers << " workers." << std::endl;
+		return MAXWORKERS;
+	}
+
+	Worker & oWorker = m_pWorkers[dWorker];
+	oWorker.dPid        = static_cast<uint64_t>(getpid());
+	oWorker.dIterations = 0;
+	oWorker.dMinWeight  = UINT64_MAX;
+	oWorker.dUpdated    = SearchStatistics::Now();
+	oWorker.dState.store(RUNNING, std::memory_order_release);
+	return static_cast<uint32_t>(dWorker);
+}
+
+void
+SharedBoard::Leave(uint32_t dWorker) {
+	assert(IsAttached() && dWorker < m_pHeader->dMaxWorkers);
+	m_pWorkers[dWorker].dUpdated = SearchStatistics::Now();
+	m_pWorkers[dWorker].dState.store(FINISHED, std::memory_order_release);
+}
+
+void
+SharedBoard::SetProgress(uint32_t dWorker, uint64_t dIterations, uint64_t dMinWeight) {
+	assert(IsAttached() && dWorker < m_pHeader->dMaxWorkers);
+	m_pWorkers[dWorker].dIterations = dIterations;
+	m_pWorkers[dWorker].dMinWeight  = dMinWeight;
+	m_pWorkers[dWorker].dUpdated    = SearchStatistics::Now();
+}
+
+SharedBoard::WorkerInfo
+SharedBoard::GetWorker(uint32_t dWorker) const {
+	assert(IsAttached() && dWorker < m_pHeader->dMaxWorkers);
+
+	const Worker & oWorker = m_pWorkers[dWorker];
+	WorkerInfo oInfo;
+	oInfo.dState      = oWorker.dState.load(std::memory_order_acquire);
+	oInfo.dPid        = oWorker.dPid;
+	oInfo.dIterations = oWorker.dIterations;
+	oInfo.dMinWeight  = oWorker.dMinWeight;
+	oInfo.dUpdated    = oWorker.dUpdated;
+
+	// a worker which was killed never leaves
+	if(oInfo.dState == RUNNING && kill(static_cast<pid_t>(oInfo.dPid), 0) != 0 && errno == ESRCH)
+		oInfo.dState = FINISHED;
+	return oInfo;
+}
+
+uint32_t
+SharedBoard::GetWorkers() const {
+	assert(IsAttached());
+	uint64_t dWorkers = m_pHeader->dWorkers;
+	return static_cast<uint32_t>(dWorkers < m_pHeader->dMaxWorkers ? dWorkers : m_pHeader->dMaxWorkers);
+}
+
+bool
+SharedBoard::IsFinished() const {
+	uint32_t dWorkers = GetWorkers();
+
+	if(dWorkers == 0)
+		return false;
+	for(uint32_t i = 0; i < dWorkers; i++)
+		if(GetWorker(i).dState != FINISHED)
+			return false;
+	return true;
+}
+
+uint64_t
+SharedBoard::GetBestWeight() const {
+	assert(IsAttached());
+	return m_pHeader->dBestWeight.load(std::memory_order_acquire);
+}
+
+bool
+SharedBoard::Offer(const CodeWord & oCodeWord, uint64_t dWeight) {
+	assert(IsAttached() && oCodeWord.GetLength() == m_pHeader->dLength);
+
+	// most offers are rejected without the lock
+	if(dWeight >= GetBestWeight())
+		return false;
+
+	uint64_t * pBest = reinterpret_cast<uint64_t*>(m_pWorkers+m_pHeader->dMaxWorkers);
+	bool bBetter = false;
+	Lock();
+	if(dWeight < m_pHeader->dBestWeight.load(std::memory_order_relaxed)) {
+		for(uint64_t i = 0; i < oCodeWord.GetLength64(); i++)
+			pBest[i] = oCodeWord.At64(i);
+		m_pHeader->dBestWeight.store(dWeight, std::memory_order_release);
+		m_pHeader->dGeneration++;
+		bBetter = true;
+	}
+	Unlock();
+	return bBetter;
+}
+
+uint64_t
+SharedBoard::GetBest(CodeWord & oCodeWord) const {
+	assert(IsAttached());
+
+	uint32_t dWordSize = sizeof(uint64_t)*8;
+	uint64_t dLength   = m_pHeader->dLength;
+	const uint64_t * pBest = reinterpret_cast<const uint64_t*>(m_pWorkers+m_pHeader->dMaxWorkers);
+	std::vector<uint64_t> vBest((dLength+dWordSize-1)/dWordSize);
+
+	Lock();
+	uint64_t dGeneration = m_pHeader->dGeneration;
+	for(uint64_t i = 0; i < vBest.size(); i++)
+		vBest[i] = pBest[i];
+	Unlock();
+
+	// the last word is right-aligned as by CodeWord::At64
+	oCodeWord = CodeWord();
+	if(dGeneration == 0)
+		return 0;
+	for(uint64_t i = 0; i < dLength/dWordSize; i++)
+		oCodeWord.Push64(vBest[i]);
+	for(uint64_t i = 0; i < dLength%dWordSize; i++)
+		oCodeWord.PushBool((vBest.back() >> (dLength%dWordSize-1-i)) & 1);
+	return dGeneration;
+}
+
+uint64_t
+SharedBoard::GetGeneration() const {
+	assert(IsAttached());
+	return m_pHeader->dGeneration.load(std::memory_order_acquire);
+}
+
+void
+SharedBoard::Stop() {
+	assert(IsAttached());
+	m_pHeader->dStop = 1;
+}
+
+bool
+SharedBoard::IsStopped() const {
+	assert(IsAttached());
+	return m_pHeader->dStop.load(std::memory_order_relaxed) != 0;
+}
+
+void
+SharedBoard::Lock() const {
+	uint64_t dFree = 0;
+	while(!m_pHeader->dLock.compare_exchange_weak(dFree, 1, std::memory_order_acquire)) {
+		dFree = 0;
+		std::this_thread::yield();
+	}
+}
+
+void
+SharedBoard::Unlock() const {
+	m_pHeader->dLock.store(0, std::memory_order_release);
+}
+
+void
+SharedBoard::Print(std::ostream & oStream) {
+	uint64_t dNow        = SearchStatistics::Now();
+	uint64_t dIterations = 0;
+	uint32_t dRunning    = 0;
+	uint32_t dWorkers    = GetWorkers();
+
+	oStream << "worker\tpid\tstate\titerations\tminimum\tlast update (s)" << std::endl;
+	for(uint32_t i = 0; i < dWorkers; i++) {
+		WorkerInfo oInfo = GetWorker(i);
+		dIterations += oInfo.dIterations;
+		if(oInfo.dState == RUNNING)
+			dRunning++;
+		oStream << i << "\t" << oInfo.dPid << "\t" << (oInfo.dState == RUNNING ? "running" : "finished")
+		        << "\t" << oInfo.dIterations << "\t\t";
+		if(oInfo.dMinWeight == UINT64_MAX)
+			oStream << "-";
+		else
+			oStream << oInfo.dMinWeight;
+		oStream << "\t" << std::fixed << std::setprecision(1)
+		        << static_cast<double>(dNow-oInfo.dUpdated)*1e-9 << std::endl;
+	}
+
+	double dSeconds = static_cast<double>(dNow-m_dLastTime)*1e-9;
+	oStream << "Total: " << dRunning << " of " << dWorkers << " workers running, "
+	        << dIterations << " iterations, " << std::setprecision(1)
+	        << (dSeconds > 0 ? static_cast<double>(dIterations-m_dLastIterations)/dSeconds : 0.0)
+	        << " iterations/s, minimum ";
+	if(GetBestWeight() == UINT64_MAX)
+		oStream << "-" << std::endl;
+	else
+		oStream << GetBestWeight() << std::endl;
+	oStream.unsetf(std::ios::floatfield);
+
+	m_dLastIterations = dIterations;
+	m_dLastTime       = dNow;
+}
+
+//EOF
@@ -0,0 +1,158 @@
+/*!
+  \file WeightTable.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief This file contains the implementation of the class WeightTable.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#include <cassert>
+
+#include "WeightTable.h"
+
+WeightTable::WeightTable(void) : m_dClasses(0), m_bTables(false) {
+}
+
+WeightTable::WeightTable(const std::vector<uint64_t> & vWeights) : m_dClasses(0), m_bTables(false) {
+	SetWeights(vWeights);
+}
+
+WeightTable::~WeightTable(void) {
+}
+
+void
+WeightTable::SetWeights(const std::vector<uint64_t> & vWeights) {
+	m_vWeights = vWeights;
+	Build();
+}
+
+void
+WeightTable::SetWeight(uint64_t dBit, uint64_t dWeight) {
+	assert(dBit < m_vWeights.size());
+
+	if(m_vWeights[dBit] == dWeight)
+		return;
+	m_vWeights[dBit] = dWeight;
+
+	if(m_bTables) {
+		BuildTable(dBit/8);
+		return;
+	}
+
+	uint32_t c = 0;
+	while(c < m_dClasses && m_aClassWeights[c] != dWeight)
+		c++;
+	if(dWeight != 0 && c == m_dClasses) {
+		// a new weight, the tables are used if there are too many classes
+		if(m_dClasses == MAXCLASSES) {
+			Build();
+			return;
+		}
+		m_aClassWeights[m_dClasses++] = dWeight;
+	}
+	BuildMasks(dBit/64);
+}
+
+uint64_t
+WeightTable::GetWeight(uint64_t dBit) const {
+	assert(dBit < m_vWeights.size());
+	return m_vWeights[dBit];
+}
+
+uint64_t
+WeightTable::Weight(const uint64_t * pData, uint64_t dWords) const {
+	uint64_t dWeight = 0;
+
+	assert(dWords <= GetWords());
+	for(uint64_t i = 0; i < dWords; i++)
+		dWeight += Weight(pData[i], i);
+	return dWeight;
+}
+
+uint64_t
+WeightTable::GetBits() const {
+	return m_vWeights.size();
+}
+
+uint64_t
+WeightTable::GetWords() const {
+	return (m_vWeights.size()+63)/64;
+}
+
+bool
+WeightTable::UsesTables() const {
+	return m_bTables;
+}
+
+void
+WeightTable::Build() {
+	m_dClasses = 0;
+	m_bTables  = false;
+	for(uint64_t i = 0; i < m_vWeights.size() && !m_bTables; i++) {
+		uint32_t c = 0;
+		while(c < m_dClasses && m_aClassWeights[c] != m_vWeights[i])
+			c++;
+		if(m_vWeights[i] == 0 || c < m_dClasses)
+			continue;
+		if(m_dClasses == MAXCLASSES)
+			m_bTables = true;
+		else
+			m_aClassWeights[m_dClasses++] = m_vWeights[i];
+	}
+
+	m_vMasks.clear();
+	m_vTables.clear();
+	if(m_bTables) {
+		m_vTables.resize(GetWords()*8*256);
+		for(uint64_t b = 0; b < GetWords()*8; b++)
+			BuildTable(b);
+	}
+	else {
+		m_vMasks.resize(GetWords()*MAXCLASSES);
+		for(uint64_t w = 0; w < GetWords(); w++)
+			BuildMasks(w);
+	}
+}
+
+void
+WeightTable::BuildMasks(uint64_t dWord) {
+	uint64_t * pMasks = &m_vMasks[dWord*MAXCLASSES];
+
+	for(uint32_t c = 0; c < MAXCLASSES; c++)
+		pMasks[c] = 0;
+	for(uint64_t j = 0; j < 64 && dWord*64+j < m_vWeights.size(); j++)
+		for(uint32_t c = 0; c < m_dClasses; c++)
+			if(m_aClassWeights[c] == m_vWeights[dWord*64+j])
+				pMasks[c] |= static_cast<uint64_t>(1) << (63-j);
+}
+
+void
+WeightTable::BuildTable(uint64_t dByte) {
+	uint64_t * pTable = &m_vTables[dByte*256];
+	uint64_t aWeights[8];
+
+	// bit 7-k of a byte value is bit 8*dByte+k of the row
+	for(uint64_t k = 0; k < 8; k++)
+		aWeights[k] = dByte*8+k < m_vWeights.size() ? m_vWeights[dByte*8+k] : 0;
+	pTable[0] = 0;
+	for(uint64_t v = 1; v < 256; v++) {
+		uint64_t dLow = v & (~v+1);
+		pTable[v] = pTable[v ^ dLow] + aWeights[7-__builtin_ctzll(dLow)];
+	}
+}
+
+//EOF
@@ -0,0 +1,333 @@
+/*!
+  \file tests.cpp
+  \author Tomislav Nad, Tomislav.Nad@iaik.tugraz.at
+  \version 0.9
+  \brief Regression tests of the library.
+*/
+// Copyright (c) 2010 Graz University of Technology (IAIK) <http://www.iaik.tugraz.at>
+//
+// This file is part of the CodingTool.
+//
+// The CodingTool is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// CodingTool is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CodingTool.  If not, see <http://www.gnu.org/licenses/>.
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <cstdio>
+
+
+#include "CodeMatrix.h"
+#include "RandomNumberGenerator.h"
+#include "LowWeightSearch.h"
+#include "InputHandler.h"
+#include "CodeWordFile.h"
+#include "types.h"
+
+using namespace std;
+
+//! Number of failed checks.
+static uint32_t dFailed = 0;
+
+//! Prints an error if the condition does not hold.
+#define CHECK(x) do { if(!(x)) { cout << "Error: " << __FILE__ << ":" << __LINE__ << ": " << #x << endl; dFailed++; } } while(0)
+
+//! Returns a random matrix.
+static CodeMatrix
+RandomMatrix(RandomNumberGenerator & oRnGen, uint64_t dRows, uint64_t dColumns) {
+	CodeMatrix oMatrix;
+	for(uint64_t i = 0; i < dRows; i++) {
+		CodeWord oRow;
+		for(uint64_t j = 0; j < dColumns; j++)
+			oRow.PushBool(oRnGen.getRandomPosInteger(2) == 1);
+		oMatrix.AddRow(oRow);
+	}
+	return oMatrix;
+}
+
+//! Appends rows of a matrix to the matrix itself, the storage grows meanwhile.
+static void
+TestSelfAppend() {
+	RandomNumberGenerator oRnGen(1);
+	CodeMatrix oMatrix = RandomMatrix(oRnGen, 8, 100);
+	CodeMatrix oCopy   = oMatrix;
+
+	for(uint64_t i = 0; i < 100; i++)
+		oMatrix.AddRow(oMatrix[i % 8]);
+	CHECK(oMatrix.GetRows() == 108);
+	for(uint64_t i = 0; i < 108; i++) {
+		CHECK(oMatrix[i] == oCopy[i % 8]);
+		CHECK(oMatrix[i].GetHammingWeight() == oCopy[i % 8].GetHammingWeight());
+	}
+}
+
+//! Moves, swaps and resizes matrices.
+static void
+TestMoveAndSwap() {
+	RandomNumberGenerator oRnGen(2);
+	CodeMatrix oMatrix = RandomMatrix(oRnGen, 70, 200);
+	CodeMatrix oCopy   = oMatrix;
+
+	oMatrix.SwapRows(3, 5);
+	CHECK(oMatrix[3] == oCopy[5] && oMatrix[5] == oCopy[3]);
+	oMatrix.SwapRows(3, 5);
+
+	CodeMatrix oMoved(std::move(oMatrix));
+	CHECK(oMatrix.GetRows() == 0 && oMoved.GetRows() == 70);
+	oMoved.Resize(200, oMoved.GetColumns());
+	CHECK(oMoved[69] == oCopy[69] && oMoved[199].GetHammingWeight() == 0);
+	oMoved.Resize(10, oMoved.GetColumns());
+	oMoved.Resize(70, oMoved.GetColumns());
+	CHECK(oMoved[9] == oCopy[9] && oMoved[69].GetHammingWeight() == 0);
+}
+
+//! Writes and reads a matrix in the binary format, mapped and from a stream.
+static void
+TestBinaryMatrix() {
+	RandomNumberGenerator oRnGen(7);
+	CodeMatrix oMatrix = RandomMatrix(oRnGen, 50, 150);
+	CodeMatrix oMapped, oStream;
+
+	CHECK(oMatrix.WriteBinaryFile("tests.cm"));
+	CHECK(CodeMatrix::IsBinaryFile("tests.cm"));
+	CHECK(oMapped.ReadBinaryFile("tests.cm"));
+	ifstream oFile("tests.cm", ios::in | ios::binary);
+	CHECK(oStream.ReadBinary(oFile));
+	oFile.close();
+
+	CHECK(oMapped.GetRows() == 50 && oMapped.GetColumns() == 150);
+	CHECK(oStream.GetRows() == 50 && oStream.GetColumns() == 150);
+	if(oMapped.GetRows() != 50 || oStream.GetRows() != 50)
+		return;
+	for(uint64_t i = 0; i < 50; i++) {
+		CHECK(oMapped[i] == oMatrix[i] && oStream[i] == oMatrix[i]);
+		CHECK(oMapped[i].GetHammingWeight() == oMatrix[i].GetHammingWeight());
+		CHECK(oStream[i].GetHammingWeight() == oMatrix[i].GetHammingWeight());
+	}
+
+	// changes of a mapped matrix are not written back
+	oMapped.SetBool(0, 149, !oMapped.AtBool(0, 149));
+	CodeMatrix oAgain;
+	CHECK(oAgain.ReadBinaryFile("tests.cm") && oAgain[0] == oMatrix[0]);
+	remove("tests.cm");
+}
+
+//! Searches a code with fewer redundant columns than sigma.
+static void
+TestSmallCode() {
+	RandomNumberGenerator oRnGen(3);
+	CodeMatrix oGenerator = RandomMatrix(oRnGen, 20, 30);
+	const char * aArgs[] = {"tests", "-i", "50", "-s", "16", "-t", "1", "-sd", "1", "-d", "1", "-o", "tests.cw"};
+	Parameters oParameters;
+	InputHandler oInputHandler(oParameters);
+	LowWeightSearch oLowWS;
+
+	CHECK(!oInputHandler.ParseSettings(sizeof(aArgs)/sizeof(aArgs[0]), aArgs));
+	CodeWord oCodeWord = oLowWS.Search(oGenerator, oParameters);
+	CHECK(oCodeWord.GetLength() == 30 && oCodeWord.GetHammingWeight() > 0);
+}
+
+//! Runs a search and returns the seed it prints.
+static uint64_t
+SearchWithSeed(CodeMatrix & oGenerator, const std::string & sSeed, CodeWord & oCodeWord) {
+	const char * aArgs[] = {"tests", "-i", "20", "-s", "8", "-t", "1", "-pc", "1", "-sd", sSeed.c_str(),
+	                        "-d", "1", "-o", "tests.cw"};
+	Parameters oParameters;
+	InputHandler oInputHandler(oParameters);
+	LowWeightSearch oLowWS;
+	ostringstream oOutput;
+
+	CHECK(!oInputHandler.ParseSettings(sizeof(aArgs)/sizeof(aArgs[0]), aArgs));
+	streambuf * pCout = cout.rdbuf(oOutput.rdbuf());
+	oCodeWord = oLowWS.Search(oGenerator, oParameters);
+	cout.rdbuf(pCout);
+
+	string sOutput = oOutput.str();
+	size_t dPos = sOutput.find("Info: Seed = ");
+	CHECK(dPos != string::npos);
+	if(dPos == string::npos)
+		return 0;
+	return strtoull(sOutput.c_str()+dPos+13, NULL, 10);
+}
+
+//! A random seed printed by the search reproduces the search.
+static void
+TestSeedRoundTrip() {
+	RandomNumberGenerator oRnGen(4);
+	CodeMatrix oGenerator = RandomMatrix(oRnGen, 40, 100);
+	CodeWord oFirst, oSecond;
+
+	uint64_t dSeed = SearchWithSeed(oGenerator, "0", oFirst);
+	ostringstream oSeed;
+	oSeed << dSeed;
+	CHECK(SearchWithSeed(oGenerator, oSeed.str(), oSecond) == dSeed);
+	CHECK(oFirst.GetLength() > 0 && oFirst == oSecond);
+}
+
+//! The Gauss combinations transform the generator matrix into a systematic one.
+static void
+TestGaussCombinations() {
+	RandomNumberGenerator oRnGen(5);
+	CodeMatrix oGenerator = RandomMatrix(oRnGen, 40, 100);
+	const char * aArgs[] = {"tests", "-i", "20", "-s", "8", "-t", "1", "-pc", "1", "-sd", "1", "-d", "1", "-o", "tests.cw"};
+	Parameters oParameters;
+	InputHandler oInputHandler(oParameters);
+	LowWeightSearch oLowWS;
+
+	CHECK(!oInputHandler.ParseSettings(sizeof(aArgs)/sizeof(aArgs[0]), aArgs));
+	oLowWS.Search(oGenerator, oParameters);
+	CHECK(oLowWS.GetGaussCombinations().GetRows() == 0);
+
+	oLowWS.SetGaussTracking(true);
+	oLowWS.Search(oGenerator, oParameters);
+	CodeMatrix & oCombinations = oLowWS.GetGaussCombinations();
+	CHECK(oCombinations.GetRows() == 40);
+	if(oCombinations.GetRows() != 40)
+		return;
+
+	// each row has a one in a column, in which all other rows are zero
+	CodeMatrix oSystematic;
+	for(uint64_t i = 0; i < 40; i++) {
+		CodeWord oRow;
+		oRow.Resize(100);
+		for(uint64_t j = 0; j < 40; j++)
+			if(oCombinations.AtBool(i, j))
+				oRow ^= oGenerator[j];
+		oSystematic.AddRow(oRow);
+	}
+	vector<bool> vPivot(40, false);
+	for(uint64_t j = 0; j < 100; j++) {
+		uint64_t dOnes = 0, dRow = 0;
+		for(uint64_t i = 0; i < 40; i++)
+			if(oSystematic.AtBool(i, j)) {
+				dOnes++;
+				dRow = i;
+			}
+		if(dOnes == 1)
+			vPivot[dRow] = true;
+	}
+	for(uint64_t i = 0; i < 40; i++)
+		CHECK(vPivot[i]);
+}
+
+//! Writes code words of several lengths as text and binary records and reads them back.
+static void
+TestCodeWordRecords() {
+	RandomNumberGenerator oRnGen(8);
+	uint64_t aLengths[] = { 1, 63, 64, 65 };
+	vector<CodeWord> vWritten;
+
+	for(uint64_t l = 0; l < sizeof(aLengths)/sizeof(aLengths[0]); l++) {
+		CodeWord oCodeWord;
+		for(uint64_t j = 0; j < aLengths[l]; j++)
+			oCodeWord.PushBool(oRnGen.getRandomPosInteger(2) == 1);
+		// the last bit is set, a wrong alignment of the last word loses it
+		oCodeWord.SetBool(aLengths[l]-1, 1);
+		vWritten.push_back(oCodeWord);
+	}
+
+	for(uint32_t b = 0; b < 2; b++) {
+		Parameters oParameters;
+		CodeWordFile oOutput;
+		oOutput.SetParameters(oParameters);
+		oOutput.SetBinary(b == 1);
+		CHECK(oOutput.Write("tests.cw"));
+		for(uint64_t i = 0; i < vWritten.size(); i++)
+			CHECK(oOutput.WriteCodeWord(vWritten[i]));
+		oOutput.Close();
+
+		CodeWordFile oInput;
+		CHECK(oInput.Read("tests.cw"));
+		const CodeWordFile::CodeWordList & vRead = oInput.GetCodeWords();
+		CHECK(vRead.size() == vWritten.size());
+		for(uint64_t i = 0; i < vRead.size() && i < vWritten.size(); i++) {
+			CHECK(vRead[i].GetLength() == vWritten[i].GetLength());
+			if(vRead[i].GetLength() == vWritten[i].GetLength()) {
+				CHECK(vRead[i] == vWritten[i]);
+				CHECK(vRead[i].GetHammingWeight() == vWritten[i].GetHammingWeight());
+			}
+		}
+	}
+}
+
+//! A checkpoint without Gauss combinations is resumed with a warning.
+static void
+TestResumeWithoutCombinations() {
+	RandomNumberGenerator oRnGen(6);
+	CodeMatrix oGenerator = RandomMatrix(oRnGen, 40, 100);
+	const char * aWrite[] = {"tests", "-i", "10", "-s", "8", "-t", "1", "-sd", "1", "-cp", "tests.ckp",
+	                         "-d", "1", "-o", "tests.cw"};
+	const char * aResume[] = {"tests", "-i", "20", "-s", "8", "-t", "2", "-r", "tests.ckp",
+	                          "-d", "1", "-o", "tests.cw"};
+	Parameters oWrite, oResume;
+	InputHandler oWriteHandler(oWrite), oResumeHandler(oResume);
+	LowWeightSearch oLowWS;
+	ostringstream oOutput;
+
+	CHECK(!oWriteHandler.ParseSettings(sizeof(aWrite)/sizeof(aWrite[0]), aWrite));
+	CHECK(!oResumeHandler.ParseSettings(sizeof(aResume)/sizeof(aResume[0]), aResume));
+	streambuf * pCout = cout.rdbuf(oOutput.rdbuf());
+	oLowWS.Search(oGenerator, oWrite);
+	oLowWS.SetGaussTracking(true);
+	CodeWord oCodeWord = oLowWS.Search(oGenerator, oResume);
+	cout.rdbuf(pCout);
+
+	string sOutput = oOutput.str();
+	CHECK(oCodeWord.GetLength() == 100);
+	CHECK(sOutput.find("Warning: The checkpoint tests.ckp has no Gauss combinations") != string::npos);
+	CHECK(sOutput.find("Warning: The checkpoint has 1 search chains") != string::npos);
+	CHECK(oLowWS.GetGaussCombinations().GetRows() == 0);
+	remove("tests.ckp");
+}
+
+//! A 64-bit seed written to the header of a code word file is read back.
+static void
+TestHeaderRoundTrip() {
+	Parameters oParameters;
+	oParameters.SetParameter(Parameters::SEED, static_cast<uint64_t>(1099511627776ULL));
+	oParameters.SetParameter(Parameters::OUTPUT, "tests.cw");
+
+	CodeWordFile oOutput;
+	oOutput.SetParameters(oParameters);
+	CHECK(oOutput.Write("tests.cw"));
+	oOutput.Close();
+
+	CodeWordFile oInput;
+	CHECK(oInput.Read("tests.cw"));
+	Parameters oRead = oInput.GetParameters();
+	CHECK(oRead.GetIntegerParameter(Parameters::SEED) == 1099511627776ULL);
+	CHECK(oRead.GetStringParameter(Parameters::OUTPUT) == "tests.cw");
+}
+
+int main(int argc, const char* argv[]) {
+
+	TestSelfAppend();
+	TestMoveAndSwap();
+	TestBinaryMatrix();
+	TestSmallCode();
+	TestSeedRoundTrip();
+	TestGaussCombinations();
+	TestHeaderRoundTrip();
+	TestCodeWordRecords();
+	TestResumeWithoutCombinations();
+
+	if(dFailed > 0) {
+		cout << dFailed << " checks failed" << endl;
+		return 1;
+	}
+	cout << "All tests passed" << endl;
+	return 0;
+}